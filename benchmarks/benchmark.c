@@ -0,0 +1,532 @@
+#include "../libfixmath/fix32.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* Micro benchmarks for libfixmath.
+ *
+ * Every function is called for a table of pseudo random inputs and the
+ * average time per call is reported. The calls are independent of each
+ * other, so this measures throughput rather than latency.
+ */
+
+#define INPUT_COUNT 4096
+#define ROUNDS      256
+
+static fix32_t a[INPUT_COUNT];
+static fix32_t b[INPUT_COUNT];
+static fix32_t out[INPUT_COUNT];
+static fix32_t pairs[2 * INPUT_COUNT]; /* a and b interleaved */
+static uint32_t float_bits[INPUT_COUNT]; /* a as IEEE 754 floats */
+static uint64_t double_bits[INPUT_COUNT]; /* a as IEEE 754 doubles */
+static char strings[INPUT_COUNT][48];     /* a as decimal strings */
+
+/* Buffers for the block processing functions, 16 rounds of 64K samples
+ * are the same amount of work as the input table.
+ */
+#define BUFFER_COUNT  65536
+#define BUFFER_ROUNDS 16
+
+static fix32_t buffer_in[BUFFER_COUNT];
+static fix32_t buffer_out[BUFFER_COUNT];
+static char text[BUFFER_COUNT * 48];     /* buffer_in as comma separated text */
+static volatile fix32_t sink;
+
+static uint64_t rand_state = 0x9E3779B97F4A7C15;
+
+static uint64_t rand64(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 7;
+	rand_state ^= rand_state << 17;
+	return rand_state;
+}
+
+/* Fills the input table with values uniformly distributed in [lo, hi). */
+static void fill(fix32_t *inputs, fix32_t lo, fix32_t hi)
+{
+	int i;
+	for (i = 0; i < INPUT_COUNT; i++)
+		inputs[i] = lo + (fix32_t)(rand64() % (uint64_t)(hi - lo));
+}
+
+static double now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* TSC cycles per ns on x86, measured once, 0 elsewhere. */
+static double cycles_per_ns;
+
+static void calibrate(void)
+{
+	#if defined(__x86_64__) || defined(__i386__)
+	double start = now_ns();
+	uint64_t start_cycles = __rdtsc();
+	while (now_ns() - start < 1e8)
+		;
+	cycles_per_ns = (double)(__rdtsc() - start_cycles) / (now_ns() - start);
+	#endif
+}
+
+static void report(const char *name, double ns)
+{
+	printf("%-32s %9.2f ns/call %9.2f Mcalls/s", name, ns, 1e3 / ns);
+	if (cycles_per_ns > 0)
+		printf(" %7.1f cycles/call", ns * cycles_per_ns);
+	printf("\n");
+}
+
+/* Runs the expression for every input, the loop index is i. */
+#define BENCH(name, expr) do { \
+	fix32_t acc = 0; \
+	int r, i; \
+	double start = now_ns(); \
+	for (r = 0; r < ROUNDS; r++) \
+		for (i = 0; i < INPUT_COUNT; i++) \
+			acc += (fix32_t)(expr); \
+	sink = acc; \
+	report(name, (now_ns() - start) / ((double)ROUNDS * INPUT_COUNT)); \
+} while (0)
+
+/* Runs the statement once per round, it should process the whole input
+ * table into out. The time is reported per element.
+ */
+#define BENCH_ARRAY(name, stmt) do { \
+	int r; \
+	double start = now_ns(); \
+	for (r = 0; r < ROUNDS; r++) \
+		stmt; \
+	sink = out[r % INPUT_COUNT]; \
+	report(name, (now_ns() - start) / ((double)ROUNDS * INPUT_COUNT)); \
+} while (0)
+
+/* Runs the statement once per round, it should process buffer_in into
+ * buffer_out. The time is reported per sample.
+ */
+#define BENCH_BUFFER(name, stmt) do { \
+	int r; \
+	double start = now_ns(); \
+	for (r = 0; r < BUFFER_ROUNDS; r++) \
+		stmt; \
+	sink = buffer_out[r % BUFFER_COUNT]; \
+	report(name, (now_ns() - start) / ((double)BUFFER_ROUNDS * BUFFER_COUNT)); \
+} while (0)
+
+/* Like BENCH_BUFFER for text parsing and formatting, reports the
+ * throughput in MB/s of text as well.
+ */
+#define BENCH_TEXT(name, len, stmt) do { \
+	int r; \
+	double start = now_ns(), ns; \
+	for (r = 0; r < BUFFER_ROUNDS; r++) \
+		stmt; \
+	ns = now_ns() - start; \
+	sink = buffer_out[r % BUFFER_COUNT]; \
+	report(name, ns / ((double)BUFFER_ROUNDS * BUFFER_COUNT)); \
+	printf("%-32s %9.1f MB/s\n", "", (double)BUFFER_ROUNDS * (len) * 1e3 / ns); \
+} while (0)
+
+#define SECTION(x) printf("\n----" x "----\n");
+
+/* Vector normalization, the sums let BENCH accumulate the results. */
+static fix32_t normalize2_rsqrt(fix32_t x, fix32_t y)
+{
+	fix32_normalize2(&x, &y);
+	return x + y;
+}
+
+static fix32_t normalize2_sqrt_div(fix32_t x, fix32_t y)
+{
+	fix32_t length = fix32_sqrt(fix32_mul(x, x) + fix32_mul(y, y));
+	return fix32_div(x, length) + fix32_div(y, length);
+}
+
+static fix32_t normalize3_rsqrt(fix32_t x, fix32_t y, fix32_t z)
+{
+	fix32_normalize3(&x, &y, &z);
+	return x + y + z;
+}
+
+static fix32_t normalize3_sqrt_div(fix32_t x, fix32_t y, fix32_t z)
+{
+	fix32_t length = fix32_sqrt(fix32_mul(x, x) + fix32_mul(y, y) + fix32_mul(z, z));
+	return fix32_div(x, length) + fix32_div(y, length) + fix32_div(z, length);
+}
+
+static fix32_t normalize3_recip_mul(fix32_t x, fix32_t y, fix32_t z)
+{
+	fix32_t recip = fix32_div(fix32_one, fix32_sqrt(fix32_mul(x, x) + fix32_mul(y, y) + fix32_mul(z, z)));
+	return fix32_mul(x, recip) + fix32_mul(y, recip) + fix32_mul(z, recip);
+}
+
+static int to_str_fix32(fix32_t x, int decimals)
+{
+	char buf[48];
+	fix32_to_str(x, buf, decimals);
+	return buf[1];
+}
+
+static int to_str_shortest(fix32_t x)
+{
+	char buf[48];
+	fix32_to_str_shortest(x, buf);
+	return buf[1];
+}
+
+static int to_str_snprintf(fix32_t x)
+{
+	char buf[48];
+	snprintf(buf, sizeof(buf), "%f", fix32_to_dbl(x));
+	return buf[1];
+}
+
+static fix32_t from_str_strtod(const char *str)
+{
+	return fix32_from_dbl(strtod(str, NULL));
+}
+
+/* The same as fix32_format_array with a fixed number of decimals. */
+static size_t format_array_fixed(const fix32_t *values, size_t count, char *buf, int decimals)
+{
+	char *p = buf;
+	size_t n;
+	for (n = 0; n < count; n++)
+	{
+		if (n > 0)
+			*p++ = ',';
+		fix32_to_str(values[n], p, decimals);
+		p += strlen(p);
+	}
+	return (size_t)(p - buf);
+}
+
+/* The same as fix32_parse_buffer with strtod, for comparison. */
+static size_t parse_buffer_strtod(const char *buf, fix32_t *values, size_t cap)
+{
+	size_t n = 0;
+	char *end;
+	while (n < cap && *buf != '\0')
+	{
+		values[n++] = fix32_from_dbl(strtod(buf, &end));
+		buf = (*end == ',') ? end + 1 : end;
+	}
+	return n;
+}
+
+int main()
+{
+	calibrate();
+
+	{
+		SECTION("binary float / double conversions");
+		fill(a, fix32_from_int(-100000), fix32_from_int(100000));
+		float_from_fix32_bin_array(a, float_bits, INPUT_COUNT);
+		BENCH("fix32_from_float_bin", fix32_from_float_bin(&float_bits[i]));
+		BENCH("float_from_fix32_bin", float_from_fix32_bin(a[i]));
+		BENCH_ARRAY("fix32_from_float_bin_array", fix32_from_float_bin_array(float_bits, out, INPUT_COUNT));
+		BENCH_ARRAY("float_from_fix32_bin_array", float_from_fix32_bin_array(a, float_bits, INPUT_COUNT));
+		double_bin_from_fix32_array(a, double_bits, INPUT_COUNT);
+		BENCH("fix32_from_double_bin", fix32_from_double_bin(double_bits[i]));
+		BENCH("double_bin_from_fix32", double_bin_from_fix32(a[i]));
+		BENCH_ARRAY("fix32_from_double_bin_array", fix32_from_double_bin_array(double_bits, out, INPUT_COUNT));
+		BENCH_ARRAY("double_bin_from_fix32_array", double_bin_from_fix32_array(a, double_bits, INPUT_COUNT));
+	}
+
+	{
+		SECTION("atan2");
+		fill(a, fix32_from_int(-1000), fix32_from_int(1000));
+		fill(b, fix32_from_int(-1000), fix32_from_int(1000));
+		BENCH("fix32_atan2", fix32_atan2(a[i], b[i]));
+		BENCH("fix32_atan2_turns", fix32_atan2_turns(a[i], b[i]));
+		BENCH("fix32_atan", fix32_atan(a[i]));
+	}
+
+	{
+		SECTION("precision tiers, fast / mid / exact");
+		fill(a, -fix32_pi, fix32_pi);
+		BENCH("fix32_sin_fast", fix32_sin_fast(a[i]));
+		BENCH("fix32_sin_mid", fix32_sin_mid(a[i]));
+		BENCH("fix32_sin", fix32_sin(a[i]));
+		BENCH("fix32_cos_fast", fix32_cos_fast(a[i]));
+		BENCH("fix32_cos_mid", fix32_cos_mid(a[i]));
+		BENCH("fix32_cos", fix32_cos(a[i]));
+		fill(a, fix32_from_int(-1000), fix32_from_int(1000));
+		fill(b, fix32_from_int(-1000), fix32_from_int(1000));
+		BENCH("fix32_atan2_fast", fix32_atan2_fast(a[i], b[i]));
+		BENCH("fix32_atan2_mid", fix32_atan2_mid(a[i], b[i]));
+		BENCH("fix32_atan2", fix32_atan2(a[i], b[i]));
+		fill(a, fix32_from_int(-20), fix32_from_int(20));
+		BENCH("fix32_exp_fast", fix32_exp_fast(a[i]));
+		BENCH("fix32_exp_mid", fix32_exp_mid(a[i]));
+		BENCH("fix32_exp", fix32_exp(a[i]));
+		BENCH("fix32_pow2_fast", fix32_pow2_fast(a[i]));
+		BENCH("fix32_pow2_mid", fix32_pow2_mid(a[i]));
+		BENCH("fix32_pow2", fix32_pow2(a[i]));
+		fill(a, 1, fix32_from_int(1000));
+		BENCH("fix32_ln_fast", fix32_ln_fast(a[i]));
+		BENCH("fix32_ln_mid", fix32_ln_mid(a[i]));
+		BENCH("fix32_ln", fix32_ln(a[i]));
+		BENCH("fix32_log2_fast", fix32_log2_fast(a[i]));
+		BENCH("fix32_log2_mid", fix32_log2_mid(a[i]));
+		BENCH("fix32_log2", fix32_log2(a[i]));
+		BENCH("fix32_sqrt_fast", fix32_sqrt_fast(a[i]));
+		BENCH("fix32_sqrt_mid", fix32_sqrt_mid(a[i]));
+		BENCH("fix32_sqrt", fix32_sqrt(a[i]));
+	}
+
+	{
+		SECTION("rsqrt / normalize");
+		fill(a, 1, fix32_from_int(1000));
+		BENCH("fix32_rsqrt", fix32_rsqrt(a[i]));
+		BENCH("1 / sqrt via div", fix32_div(fix32_one, fix32_sqrt(a[i])));
+		fill(a, fix32_from_int(-1000), fix32_from_int(1000));
+		fill(b, fix32_from_int(-1000), fix32_from_int(1000));
+		BENCH("fix32_normalize2", normalize2_rsqrt(a[i], b[i]));
+		BENCH("normalize2 via sqrt and div", normalize2_sqrt_div(a[i], b[i]));
+		BENCH("fix32_normalize3", normalize3_rsqrt(a[i], b[i], a[i ^ 1]));
+		BENCH("normalize3 via sqrt and div", normalize3_sqrt_div(a[i], b[i], a[i ^ 1]));
+		BENCH("normalize3 via div and mul", normalize3_recip_mul(a[i], b[i], a[i ^ 1]));
+	}
+
+	{
+		SECTION("hypot");
+		int i;
+		fill(a, fix32_from_int(-30000), fix32_from_int(30000));
+		fill(b, fix32_from_int(-30000), fix32_from_int(30000));
+		for (i = 0; i < INPUT_COUNT; i++)
+		{
+			pairs[2 * i] = a[i];
+			pairs[2 * i + 1] = b[i];
+		}
+		BENCH("fix32_hypot", fix32_hypot(a[i], b[i]));
+		BENCH("sqrt of mul + mul", fix32_sqrt(fix32_mul(a[i], a[i]) + fix32_mul(b[i], b[i])));
+		BENCH("fix32_hypot3", fix32_hypot3(a[i], b[i], a[i ^ 1]));
+		BENCH_ARRAY("fix32_hypot_array", fix32_hypot_array(pairs, out, INPUT_COUNT));
+		fill(a, fix32_minimum / 2, fix32_maximum / 2);
+		fill(b, fix32_minimum / 2, fix32_maximum / 2);
+		BENCH("fix32_hypot, full range", fix32_hypot(a[i], b[i]));
+	}
+
+	{
+		SECTION("sqrt / rsqrt / magnitude arrays");
+		fill(a, 1, fix32_from_int(1000000));
+		BENCH("fix32_sqrt", fix32_sqrt(a[i]));
+		BENCH_ARRAY("fix32_sqrt_array", fix32_sqrt_array(a, out, INPUT_COUNT));
+		BENCH("fix32_rsqrt", fix32_rsqrt(a[i]));
+		BENCH_ARRAY("fix32_rsqrt_array", fix32_rsqrt_array(a, out, INPUT_COUNT));
+		fill(a, fix32_from_int(-30000), fix32_from_int(30000));
+		fill(b, fix32_from_int(-30000), fix32_from_int(30000));
+		BENCH("fix32_hypot", fix32_hypot(a[i], b[i]));
+		BENCH_ARRAY("fix32_magnitude_array", fix32_magnitude_array(a, b, out, INPUT_COUNT));
+		fill(a, fix32_minimum / 2, fix32_maximum / 2);
+		fill(b, fix32_minimum / 2, fix32_maximum / 2);
+		BENCH_ARRAY("fix32_magnitude_array, full range", fix32_magnitude_array(a, b, out, INPUT_COUNT));
+	}
+
+	{
+		SECTION("cbrt / rootn");
+		const fix32_t third = fix32_div(fix32_one, fix32_from_int(3));
+		const fix32_t fifth = fix32_div(fix32_one, fix32_from_int(5));
+		fill(a, 1, fix32_from_int(100000));
+		BENCH("fix32_cbrt", fix32_cbrt(a[i]));
+		BENCH("fix32_pow(x, 1/3)", fix32_pow(a[i], third));
+		BENCH("fix32_rootn(x, 5)", fix32_rootn(a[i], 5));
+		BENCH("fix32_pow(x, 1/5)", fix32_pow(a[i], fifth));
+		BENCH("fix32_rootn(x, 16)", fix32_rootn(a[i], 16));
+		BENCH("fix32_rootn(x, 100)", fix32_rootn(a[i], 100));
+	}
+
+	{
+		SECTION("sin / cos");
+		fill(a, -fix32_pi, fix32_pi);
+		BENCH("fix32_sin", fix32_sin(a[i]));
+		BENCH("fix32_cos", fix32_cos(a[i]));
+		BENCH_ARRAY("fix32_sin_array", fix32_sin_array(a, out, INPUT_COUNT));
+		BENCH_ARRAY("fix32_cos_array", fix32_cos_array(a, out, INPUT_COUNT));
+	}
+
+	{
+		SECTION("asin / acos");
+		fill(a, -fix32_one, fix32_one);
+		BENCH("fix32_asin", fix32_asin(a[i]));
+		BENCH("fix32_acos", fix32_acos(a[i]));
+	}
+
+	{
+		SECTION("tan");
+		fill(a, -fix32_pi, fix32_pi);
+		BENCH("fix32_tan", fix32_tan(a[i]));
+	}
+
+	{
+		SECTION("exp");
+		fill(a, fix32_from_int(-22), fix32_from_int(21));
+		BENCH("fix32_exp", fix32_exp(a[i]));
+		fill(a, -fix32_one / 2, fix32_one / 2);
+		BENCH("fix32_expm1 (|x| < 0.5)", fix32_expm1(a[i]));
+		BENCH("fix32_exp - 1 (|x| < 0.5)", fix32_exp(a[i]) - fix32_one);
+		fill(a, fix32_from_int(-22), fix32_from_int(21));
+		BENCH("fix32_expm1", fix32_expm1(a[i]));
+	}
+
+	{
+		SECTION("ln");
+		fill(a, 1, fix32_maximum);
+		BENCH("fix32_ln", fix32_ln(a[i]));
+		fill(a, -fix32_one / 2, fix32_one / 2);
+		BENCH("fix32_log1p (|x| < 0.5)", fix32_log1p(a[i]));
+		BENCH("fix32_ln(1 + x) (|x| < 0.5)", fix32_ln(fix32_one + a[i]));
+	}
+
+	{
+		SECTION("log2");
+		fill(a, 1, fix32_one);
+		BENCH("fix32_log2 (x < 1)", fix32_log2(a[i]));
+		fill(a, fix32_one, fix32_maximum);
+		BENCH("fix32_log2 (x >= 1)", fix32_log2(a[i]));
+	}
+
+	{
+		SECTION("pow2 / pow");
+		fill(a, fix32_from_int(-32), fix32_from_int(31));
+		BENCH("fix32_pow2", fix32_pow2(a[i]));
+		fill(a, 1, fix32_from_int(1000));
+		fill(b, fix32_from_int(-3), fix32_from_int(3));
+		BENCH("fix32_pow", fix32_pow(a[i], b[i]));
+	}
+
+	{
+		SECTION("powi");
+		fill(a, -fix32_from_int(8), fix32_from_int(8));
+		BENCH("fix32_powi (n = 3)", fix32_powi(a[i], 3));
+		BENCH("fix32_pow (n = 3)", fix32_pow(fix32_abs(a[i]), fix32_from_int(3)));
+		BENCH("fix32_powi (n = -2)", fix32_powi(a[i], -2));
+		BENCH("fix32_pow (n = -2)", fix32_pow(fix32_abs(a[i]), fix32_from_int(-2)));
+		BENCH("fix32_powi (n = -15..15)", fix32_powi(a[i], (int)(i & 31) - 15));
+	}
+
+	{
+		SECTION("activation functions");
+		fill(a, fix32_from_int(-8), fix32_from_int(8));
+		BENCH("fix32_tanh", fix32_tanh(a[i]));
+		BENCH("tanh via exp and div", fix32_div(fix32_exp(2 * a[i]) - fix32_one, fix32_exp(2 * a[i]) + fix32_one));
+		BENCH("fix32_sigmoid", fix32_sigmoid(a[i]));
+		BENCH("sigmoid via exp and div", fix32_div(fix32_one, fix32_one + fix32_exp(-a[i])));
+		BENCH("fix32_softplus", fix32_softplus(a[i]));
+		BENCH("fix32_gelu", fix32_gelu(a[i]));
+		BENCH_ARRAY("fix32_tanh_array", fix32_tanh_array(a, out, INPUT_COUNT));
+		BENCH_ARRAY("fix32_sigmoid_array", fix32_sigmoid_array(a, out, INPUT_COUNT));
+		BENCH_ARRAY("fix32_softplus_array", fix32_softplus_array(a, out, INPUT_COUNT));
+		BENCH_ARRAY("fix32_gelu_array", fix32_gelu_array(a, out, INPUT_COUNT));
+	}
+
+	{
+		SECTION("log10 / exp10 / dB, 64K buffers");
+		int i;
+		fill(a, 1, fix32_from_int(1000));
+		for (i = 0; i < BUFFER_COUNT; i++)
+			buffer_in[i] = a[i % INPUT_COUNT] ^ (i >> 12);
+		BENCH("fix32_log10", fix32_log10(a[i]));
+		BENCH("log10 via ln and div", fix32_div(fix32_ln(a[i]), 9889527671LL));
+		BENCH_BUFFER("fix32_log10_array", fix32_log10_array(buffer_in, buffer_out, BUFFER_COUNT));
+		BENCH_BUFFER("fix32_to_db_power_array", fix32_to_db_power_array(buffer_in, buffer_out, BUFFER_COUNT));
+		BENCH_BUFFER("fix32_to_db_amplitude_array", fix32_to_db_amplitude_array(buffer_in, buffer_out, BUFFER_COUNT));
+
+		fill(a, fix32_from_int(-9), fix32_from_int(9));
+		for (i = 0; i < BUFFER_COUNT; i++)
+			buffer_in[i] = a[i % INPUT_COUNT] ^ (i >> 12);
+		BENCH("fix32_exp10", fix32_exp10(a[i]));
+		BENCH_BUFFER("fix32_exp10_array", fix32_exp10_array(buffer_in, buffer_out, BUFFER_COUNT));
+		for (i = 0; i < BUFFER_COUNT; i++)
+			buffer_in[i] *= 20;
+		BENCH_BUFFER("fix32_from_db_array", fix32_from_db_array(buffer_in, buffer_out, BUFFER_COUNT));
+	}
+
+	{
+		SECTION("exp / ln / log2 / pow2 arrays, 64K buffers");
+		int i;
+		fill(a, fix32_from_int(-20), fix32_from_int(20));
+		for (i = 0; i < BUFFER_COUNT; i++)
+			buffer_in[i] = a[i % INPUT_COUNT] ^ (i >> 12);
+		BENCH("fix32_exp", fix32_exp(a[i]));
+		BENCH_BUFFER("fix32_exp_array", fix32_exp_array(buffer_in, buffer_out, BUFFER_COUNT));
+		BENCH("fix32_pow2", fix32_pow2(a[i]));
+		BENCH_BUFFER("fix32_pow2_array", fix32_pow2_array(buffer_in, buffer_out, BUFFER_COUNT));
+
+		fill(a, 1, fix32_maximum);
+		for (i = 0; i < BUFFER_COUNT; i++)
+			buffer_in[i] = a[i % INPUT_COUNT] >> (i & 63);
+		BENCH("fix32_ln", fix32_ln(a[i]));
+		BENCH_BUFFER("fix32_ln_array", fix32_ln_array(buffer_in, buffer_out, BUFFER_COUNT));
+		BENCH("fix32_log2", fix32_log2(a[i]));
+		BENCH_BUFFER("fix32_log2_array", fix32_log2_array(buffer_in, buffer_out, BUFFER_COUNT));
+	}
+
+	{
+		SECTION("string conversions");
+		int i;
+		fill(a, fix32_from_int(-100000), fix32_from_int(100000));
+		BENCH("fix32_to_str, 6 decimals", to_str_fix32(a[i], 6));
+		BENCH("snprintf %f of fix32_to_dbl", to_str_snprintf(a[i]));
+		BENCH("fix32_to_str, 10 decimals", to_str_fix32(a[i], 10));
+		BENCH("fix32_to_str_shortest", to_str_shortest(a[i]));
+		for (i = 0; i < INPUT_COUNT; i++)
+			fix32_to_str(a[i], strings[i], 10);
+		BENCH("fix32_from_str, 10 decimals", fix32_from_str(strings[i]));
+		BENCH("strtod and fix32_from_dbl", from_str_strtod(strings[i]));
+	}
+
+	{
+		SECTION("bulk parsing, 64K values");
+		size_t len = 0;
+		int i;
+		fill(a, fix32_from_int(-100000), fix32_from_int(100000));
+		for (i = 0; i < BUFFER_COUNT; i++)
+		{
+			fix32_to_str(a[i % INPUT_COUNT] >> (i & 15), text + len, 10);
+			len += strlen(text + len);
+			text[len++] = ',';
+		}
+		text[len] = '\0';
+		BENCH_TEXT("fix32_parse_buffer", len,
+			fix32_parse_buffer(text, len, buffer_out, BUFFER_COUNT, ',', NULL));
+		BENCH_TEXT("strtod and fix32_from_dbl", len,
+			parse_buffer_strtod(text, buffer_out, BUFFER_COUNT));
+	}
+
+	{
+		SECTION("bulk formatting, 64K values");
+		size_t shortest, fixed;
+		int i;
+		fill(a, fix32_from_int(-100000), fix32_from_int(100000));
+		for (i = 0; i < BUFFER_COUNT; i++)
+			buffer_in[i] = a[i % INPUT_COUNT] >> (i & 15);
+		fix32_format_array(buffer_in, BUFFER_COUNT, text, sizeof(text), ',', &shortest);
+		fixed = format_array_fixed(buffer_in, BUFFER_COUNT, text, 10);
+		BENCH_TEXT("fix32_format_array", shortest,
+			fix32_format_array(buffer_in, BUFFER_COUNT, text, sizeof(text), ',', NULL));
+		BENCH_TEXT("fix32_to_str, 10 decimals", fixed,
+			format_array_fixed(buffer_in, BUFFER_COUNT, text, 10));
+
+		// Round numbers, as from a sensor with a few decimals.
+		for (i = 0; i < BUFFER_COUNT; i++)
+			buffer_in[i] = fix32_div(fix32_from_int((int)(rand64() % 2000000) - 1000000), fix32_from_int(1000));
+		fix32_format_array(buffer_in, BUFFER_COUNT, text, sizeof(text), ',', &shortest);
+		fixed = format_array_fixed(buffer_in, BUFFER_COUNT, text, 10);
+		BENCH_TEXT("fix32_format_array, 3 decimals", shortest,
+			fix32_format_array(buffer_in, BUFFER_COUNT, text, sizeof(text), ',', NULL));
+		BENCH_TEXT("fix32_to_str, 10 decimals", fixed,
+			format_array_fixed(buffer_in, BUFFER_COUNT, text, 10));
+		printf("%-32s %9.2f bytes/value shortest, %.2f fixed\n", "",
+			(double)shortest / BUFFER_COUNT, (double)fixed / BUFFER_COUNT);
+	}
+
+	return 0;
+}
@@ -1,248 +1,568 @@
-#ifndef __libfixmath_fix32_h__
-#define __libfixmath_fix32_h__
-
-#ifdef __cplusplus
-extern "C"
-{
-#endif
-
-/* These options may let the optimizer to remove some calls to the functions.
- * Refer to http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html
- */
-#ifndef FIXMATH_FUNC_ATTRS
-# ifdef __GNUC__
-#   if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ > 6)
-#     define FIXMATH_FUNC_ATTRS __attribute__((leaf, nothrow, const))
-#   else
-#     define FIXMATH_FUNC_ATTRS __attribute__((nothrow, const))
-#   endif
-# else
-#   define FIXMATH_FUNC_ATTRS
-# endif
-#endif
-
-#include <stdint.h>
-
-typedef int64_t fix32_t;
-
-static const fix32_t FOUR_DIV_PI = 0x145F306DD;               /*!< Fix32 value of 4/PI */
-static const fix32_t _FOUR_DIV_PI2 = 0xFFFFFFFF983f4277;       /*!< Fix32 value of -4/PI² */
-static const fix32_t X4_CORRECTION_COMPONENT = 0x3999999A;    /*!< Fix32 value of 0.225 */
-static const fix32_t PI_DIV_4 = 0xC90FDAA2;                   /*!< Fix32 value of PI/4 */
-static const fix32_t THREE_PI_DIV_4 = 0x25B2F8FE6;            /*!< Fix32 value of 3PI/4 */
-
-static const fix32_t fix32_maximum  = 0x7FFFFFFFFFFFFFFF;     /*!< the maximum value of fix32_t */
-static const fix32_t fix32_minimum  = 0x8000000000000000;     /*!< the maximum value of fix32_t */
-static const fix32_t fix32_overflow = 0x8000000000000000;     /*!< the value used to indicate overflows when FIXMATH_NO_OVERFLOW is not specified */
-static const fix32_t fix32_epsilon = 0x0000000000000001;      /*!< the min absolute value of fix32_t */
-
-static const fix32_t fix32_pi = 13493037704;                  /*!< fix32_t value of pi */		//0x 0000 0003 243F 6A88
-static const fix32_t fix32_pi_over_2 = 6746518852;            /*!< fix32_t value of pi/2 */		//0x 0000 0001 921F B544
-static const fix32_t fix32_one_over_pi = 0x00000000517cc1b7;  /*!< fix32_t value of 1/pi */		//0x 0000 0001 921F B544
-static const fix32_t fix32_e  = 11674931555;                  /*!< fix32_t value of e */
-static const fix32_t fix32_one = 0x0000000100000000;          /*!< fix32_t value of 1 */
-
-/* Conversion functions between fix32_t and float/integer.
- * These are inlined to allow compiler to optimize away constant numbers
- */
-static inline fix32_t fix32_from_int(int a)     { return a * fix32_one; }
-static inline float   fix32_to_float(fix32_t a) { return (float)a / fix32_one; }
-static inline double  fix32_to_dbl(fix32_t a)   { return (double)a / fix32_one; }
-
-static inline int fix32_to_int(fix32_t a)
-{
-#ifdef FIXMATH_NO_ROUNDING
-	return (a >> 32);
-#else
-	if (a >= 0)
-		return (a + (fix32_one >> 1)) / fix32_one;
-	return (a - (fix32_one >> 1)) / fix32_one;
-#endif
-}
-
-static inline fix32_t fix32_from_float(float a)
-{
-	float temp = a * fix32_one;
-#ifndef FIXMATH_NO_ROUNDING
-	temp += (temp >= 0) ? 0.5f : -0.5f;
-#endif
-	return (fix32_t)temp;
-}
-
-static inline fix32_t fix32_from_dbl(double a)
-{
-	double temp = a * fix32_one;
-#ifndef FIXMATH_NO_ROUNDING
-	temp += (double)((temp >= 0) ? 0.5f : -0.5f);
-#endif
-	return (fix32_t)temp;
-}
-
-/* Converts a binary IEEE745 float to a fixed point q31.32 integer
- * without FPO
- */
-extern fix32_t fix32_from_float_bin(const void* value);
-
-/* Converts a q31.32 integer back to binary IEEE754 floating point
- * It returns uint32_t that contains the 32-bit float value
- */
-extern uint32_t float_from_fix32_bin(fix32_t value);
-
-/* Macro for defining fix32_t constant values.
-	 The functions above can't be used from e.g. global variable initializers,
-	 and their names are quite long also. This macro is useful for constants
-	 springled alongside code, e.g. F32(1.234).
-
-	 Note that the argument is evaluated multiple times, and also otherwise
-	 you should only use this for constant values. For runtime-conversions,
-	 use the functions above.
-*/
-#define F32(x) ((fix32_t)(((x) >= 0) ? ((x) * 4294967296.0 + 0.5) : ((x) * 4294967296.0 - 0.5)))
-
-static inline fix32_t fix32_abs(fix32_t x)
-	{ return (x < 0 ? -x : x); }
-static inline fix32_t fix32_floor(fix32_t x)
-	{ return (x & 0xFFFFFFFF00000000ULL); }
-static inline fix32_t fix32_ceil(fix32_t x)
-	{ return (x & 0xFFFFFFFF00000000ULL) + (x & 0x00000000FFFFFFFFULL ? fix32_one : 0); }
-static inline fix32_t fix32_min(fix32_t x, fix32_t y)
-	{ return (x < y ? x : y); }
-static inline fix32_t fix32_max(fix32_t x, fix32_t y)
-	{ return (x > y ? x : y); }
-static inline fix32_t fix32_clamp(fix32_t x, fix32_t lo, fix32_t hi)
-	{ return fix32_min(fix32_max(x, lo), hi); }
-
-/* Subtraction and addition with (optional) overflow detection. */
-#ifdef FIXMATH_NO_OVERFLOW
-
-static inline fix32_t fix32_add(fix32_t inArg0, fix32_t inArg1) { return (inArg0 + inArg1); }
-static inline fix32_t fix32_sub(fix32_t inArg0, fix32_t inArg1) { return (inArg0 - inArg1); }
-
-#else
-
-extern fix32_t fix32_add(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
-extern fix32_t fix32_sub(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
-
-/* Saturating arithmetic */
-extern fix32_t fix32_sadd(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
-extern fix32_t fix32_ssub(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
-
-#endif
-
-/*! Multiplies the two given fix16_t's and returns the result.
-*/
-extern fix32_t fix32_mul(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
-
-/*! Divides the first given fix16_t by the second and returns the result.
-*/
-extern fix32_t fix32_div(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
-
-#ifndef FIXMATH_NO_OVERFLOW
-/*! Performs a saturated multiplication (overflow-protected) of the two given fix32_t's and returns the result.
-*/
-extern fix32_t fix32_smul(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
-
-/*! Performs a saturated division (overflow-protected) of the first fix32_t by the second and returns the result.
-*/
-extern fix32_t fix32_sdiv(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
-#endif
-
-/*! Divides the first given fix32_t by the second and returns the result.
-*/
-extern fix32_t fix32_mod(fix32_t x, fix32_t y) FIXMATH_FUNC_ATTRS;
-
-
-
-/* Returns the linear interpolation: (inArg0 * (1 - inFract)) + (inArg1 * inFract):
- */
-extern fix32_t fix32_lerp8(fix32_t inArg0, fix32_t inArg1, uint8_t inFract) FIXMATH_FUNC_ATTRS;
-extern fix32_t fix32_lerp16(fix32_t inArg0, fix32_t inArg1, uint16_t inFract) FIXMATH_FUNC_ATTRS;
-extern fix32_t fix32_lerp32(fix32_t inArg0, fix32_t inArg1, uint32_t inFract) FIXMATH_FUNC_ATTRS;
-extern fix32_t fix32_lerp(fix32_t inArg0, fix32_t inArg1, fix32_t inFract) FIXMATH_FUNC_ATTRS;
-
-
-
-/*! Returns the sine of the given fix32_t.
-*/
-extern fix32_t fix32_sin_parabola(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the sine of the given fix32_t.
-*/
-extern fix32_t fix32_sin(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the cosine of the given fix32_t.
-*/
-extern fix32_t fix32_cos(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the tangent of the given fix32_t.
-*/
-extern fix32_t fix32_tan(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the arcsine of the given fix32_t.
-*/
-extern fix32_t fix32_asin(fix32_t inValue) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the arccosine of the given fix32_t.
-*/
-extern fix32_t fix32_acos(fix32_t inValue) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the arctangent of the given fix32_t.
-*/
-extern fix32_t fix32_atan(fix32_t inValue) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the arctangent of inY/inX.
-*/
-extern fix32_t fix32_atan2(fix32_t inY, fix32_t inX) FIXMATH_FUNC_ATTRS;
-
-static const fix32_t fix32_rad_to_deg_mult = 246101626061;
-static inline fix32_t fix32_rad_to_deg(fix32_t radians)
-	{ return fix32_mul(radians, fix32_rad_to_deg_mult); }
-
-static const fix32_t fix32_deg_to_rad_mult = 74947179;
-static inline fix32_t fix32_deg_to_rad(fix32_t degrees)
-	{ return fix32_mul(degrees, fix32_deg_to_rad_mult); }
-
-
-
-/*! Returns the square root of the given fix32_t.
-*/
-extern fix32_t fix32_sqrt(fix32_t inValue) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the square of the given fix32_t.
-*/
-static inline fix32_t fix32_sq(fix32_t x)
-	{ return fix32_mul(x, x); }
-
-/*! Returns the exponent (e^) of the given fix32_t.				<---------------------------------------  !!! Might give wrong returns values !!!
-*/
-extern fix32_t fix32_exp(fix32_t inValue) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the natural logarithm of the given fix32_t.
- */
-extern fix32_t fix32_ln(fix32_t inValue) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the base 2 logarithm of the given fix32_t.
- */
-extern fix32_t fix32_log2(fix32_t x) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the saturated base 2 logarithm of the given fix32_t.
- */
-extern fix32_t fix32_slog2(fix32_t x) FIXMATH_FUNC_ATTRS;
-
-/*! Returns 2 raised to the specified power.
- */
-extern fix32_t fix32_pow2(fix32_t x) FIXMATH_FUNC_ATTRS;
-
-/*! Returns a specified number raised to the specified power.
- */
-extern fix32_t fix32_pow(fix32_t b, fix32_t exp) FIXMATH_FUNC_ATTRS;
-
-/*! Returns the saturated version of fix32_pow.
- */
-extern fix32_t fix32_spow(fix32_t b, fix32_t exp) FIXMATH_FUNC_ATTRS;
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif
+#ifndef __libfixmath_fix32_h__
+#define __libfixmath_fix32_h__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* These options may let the optimizer to remove some calls to the functions.
+ * Refer to http://gcc.gnu.org/onlinedocs/gcc/Function-Attributes.html
+ */
+#ifndef FIXMATH_FUNC_ATTRS
+# ifdef __GNUC__
+#   if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ > 6)
+#     define FIXMATH_FUNC_ATTRS __attribute__((leaf, nothrow, const))
+#   else
+#     define FIXMATH_FUNC_ATTRS __attribute__((nothrow, const))
+#   endif
+# else
+#   define FIXMATH_FUNC_ATTRS
+# endif
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int64_t fix32_t;
+
+static const fix32_t FOUR_DIV_PI = 0x145F306DD;               /*!< Fix32 value of 4/PI */
+static const fix32_t _FOUR_DIV_PI2 = 0xFFFFFFFF983f4277;       /*!< Fix32 value of -4/PI² */
+static const fix32_t X4_CORRECTION_COMPONENT = 0x3999999A;    /*!< Fix32 value of 0.225 */
+static const fix32_t PI_DIV_4 = 0xC90FDAA2;                   /*!< Fix32 value of PI/4 */
+static const fix32_t THREE_PI_DIV_4 = 0x25B2F8FE6;            /*!< Fix32 value of 3PI/4 */
+
+static const fix32_t fix32_maximum  = 0x7FFFFFFFFFFFFFFF;     /*!< the maximum value of fix32_t */
+static const fix32_t fix32_minimum  = 0x8000000000000000;     /*!< the maximum value of fix32_t */
+static const fix32_t fix32_overflow = 0x8000000000000000;     /*!< the value used to indicate overflows when FIXMATH_NO_OVERFLOW is not specified */
+static const fix32_t fix32_epsilon = 0x0000000000000001;      /*!< the min absolute value of fix32_t */
+
+static const fix32_t fix32_pi = 13493037704;                  /*!< fix32_t value of pi */		//0x 0000 0003 243F 6A88
+static const fix32_t fix32_pi_over_2 = 6746518852;            /*!< fix32_t value of pi/2 */		//0x 0000 0001 921F B544
+static const fix32_t fix32_one_over_pi = 0x00000000517cc1b7;  /*!< fix32_t value of 1/pi */		//0x 0000 0001 921F B544
+static const fix32_t fix32_e  = 11674931555;                  /*!< fix32_t value of e */
+static const fix32_t fix32_one = 0x0000000100000000;          /*!< fix32_t value of 1 */
+
+/* Conversion functions between fix32_t and float/integer.
+ * These are inlined to allow compiler to optimize away constant numbers
+ */
+static inline fix32_t fix32_from_int(int a)     { return a * fix32_one; }
+static inline float   fix32_to_float(fix32_t a) { return (float)a / fix32_one; }
+static inline double  fix32_to_dbl(fix32_t a)   { return (double)a / fix32_one; }
+
+static inline int fix32_to_int(fix32_t a)
+{
+#ifdef FIXMATH_NO_ROUNDING
+	return (a >> 32);
+#else
+	if (a >= 0)
+		return (a + (fix32_one >> 1)) / fix32_one;
+	return (a - (fix32_one >> 1)) / fix32_one;
+#endif
+}
+
+static inline fix32_t fix32_from_float(float a)
+{
+	float temp = a * fix32_one;
+#ifndef FIXMATH_NO_ROUNDING
+	temp += (temp >= 0) ? 0.5f : -0.5f;
+#endif
+	return (fix32_t)temp;
+}
+
+static inline fix32_t fix32_from_dbl(double a)
+{
+	double temp = a * fix32_one;
+#ifndef FIXMATH_NO_ROUNDING
+	temp += (double)((temp >= 0) ? 0.5f : -0.5f);
+#endif
+	return (fix32_t)temp;
+}
+
+/* Converts a binary IEEE 754 float, the 4 bytes at value, to a fixed point
+ * q31.32 integer without an FPU. Rounds to nearest, ties to even (truncates
+ * with FIXMATH_NO_ROUNDING). Zero and denormals give 0, out of range values
+ * and infinities saturate to fix32_maximum or fix32_minimum, and NaN gives
+ * fix32_overflow.
+ */
+extern fix32_t fix32_from_float_bin(const void* value);
+
+/* Converts a q31.32 integer back to binary IEEE754 floating point
+ * It returns uint32_t that contains the 32-bit float value, rounded to
+ * nearest, ties to even (truncated with FIXMATH_NO_ROUNDING).
+ */
+extern uint32_t float_from_fix32_bin(fix32_t value);
+
+/* The conversions above for n values, from and to buffers of raw float
+ * bit patterns.
+ */
+extern void fix32_from_float_bin_array(const uint32_t *inBits, fix32_t *outValues, size_t n);
+extern void float_from_fix32_bin_array(const fix32_t *inValues, uint32_t *outBits, size_t n);
+
+/* Conversions from and to the bit patterns of IEEE 754 doubles, which
+ * hold 53 significant bits where a float holds 24. Rounding, saturation
+ * and the special values work like in the float versions, and values with
+ * up to 53 significant bits convert both ways exactly.
+ */
+extern fix32_t fix32_from_double_bin(uint64_t bits);
+extern uint64_t double_bin_from_fix32(fix32_t value);
+extern void fix32_from_double_bin_array(const uint64_t *inBits, fix32_t *outValues, size_t n);
+extern void double_bin_from_fix32_array(const fix32_t *inValues, uint64_t *outBits, size_t n);
+
+/* Macro for defining fix32_t constant values.
+	 The functions above can't be used from e.g. global variable initializers,
+	 and their names are quite long also. This macro is useful for constants
+	 springled alongside code, e.g. F32(1.234).
+
+	 Note that the argument is evaluated multiple times, and also otherwise
+	 you should only use this for constant values. For runtime-conversions,
+	 use the functions above.
+*/
+#define F32(x) ((fix32_t)(((x) >= 0) ? ((x) * 4294967296.0 + 0.5) : ((x) * 4294967296.0 - 0.5)))
+
+static inline fix32_t fix32_abs(fix32_t x)
+	{ return (x < 0 ? -x : x); }
+static inline fix32_t fix32_floor(fix32_t x)
+	{ return (x & 0xFFFFFFFF00000000ULL); }
+static inline fix32_t fix32_ceil(fix32_t x)
+	{ return (x & 0xFFFFFFFF00000000ULL) + (x & 0x00000000FFFFFFFFULL ? fix32_one : 0); }
+static inline fix32_t fix32_min(fix32_t x, fix32_t y)
+	{ return (x < y ? x : y); }
+static inline fix32_t fix32_max(fix32_t x, fix32_t y)
+	{ return (x > y ? x : y); }
+static inline fix32_t fix32_clamp(fix32_t x, fix32_t lo, fix32_t hi)
+	{ return fix32_min(fix32_max(x, lo), hi); }
+
+/* Subtraction and addition with (optional) overflow detection. */
+#ifdef FIXMATH_NO_OVERFLOW
+
+static inline fix32_t fix32_add(fix32_t inArg0, fix32_t inArg1) { return (inArg0 + inArg1); }
+static inline fix32_t fix32_sub(fix32_t inArg0, fix32_t inArg1) { return (inArg0 - inArg1); }
+
+#else
+
+extern fix32_t fix32_add(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_sub(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
+
+/* Saturating arithmetic */
+extern fix32_t fix32_sadd(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_ssub(fix32_t a, fix32_t b) FIXMATH_FUNC_ATTRS;
+
+#endif
+
+/*! Multiplies the two given fix16_t's and returns the result.
+*/
+extern fix32_t fix32_mul(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
+
+/*! Divides the first given fix16_t by the second and returns the result.
+*/
+extern fix32_t fix32_div(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
+
+#ifndef FIXMATH_NO_OVERFLOW
+/*! Performs a saturated multiplication (overflow-protected) of the two given fix32_t's and returns the result.
+*/
+extern fix32_t fix32_smul(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
+
+/*! Performs a saturated division (overflow-protected) of the first fix32_t by the second and returns the result.
+*/
+extern fix32_t fix32_sdiv(fix32_t inArg0, fix32_t inArg1) FIXMATH_FUNC_ATTRS;
+#endif
+
+/*! Divides the first given fix32_t by the second and returns the result.
+*/
+extern fix32_t fix32_mod(fix32_t x, fix32_t y) FIXMATH_FUNC_ATTRS;
+
+
+
+/* Returns the linear interpolation: (inArg0 * (1 - inFract)) + (inArg1 * inFract):
+ */
+extern fix32_t fix32_lerp8(fix32_t inArg0, fix32_t inArg1, uint8_t inFract) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_lerp16(fix32_t inArg0, fix32_t inArg1, uint16_t inFract) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_lerp32(fix32_t inArg0, fix32_t inArg1, uint32_t inFract) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_lerp(fix32_t inArg0, fix32_t inArg1, fix32_t inFract) FIXMATH_FUNC_ATTRS;
+
+
+
+/*! Returns the sine of the given fix32_t.
+*/
+extern fix32_t fix32_sin_parabola(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the sine of the given fix32_t.
+*/
+extern fix32_t fix32_sin(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the cosine of the given fix32_t.
+*/
+extern fix32_t fix32_cos(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+
+/*! Precision tiers.
+    sin, cos, atan2, exp, ln, log2, pow2 and sqrt have _fast and _mid
+    versions next to the exact ones, so that the precision can be chosen
+    per call site:
+    - _fast: accurate to 16 fractional bits, error below 2^-16
+    - _mid:  accurate to 24 fractional bits, error below 2^-24
+    - no suffix: accurate to the last bit, 1 LSB (2^-32)
+    The error is absolute, except for exp, pow2 and sqrt results above 1,
+    where it is relative. The errors below are the measured maxima, and the
+    cycles per call the throughput from benchmarks/benchmark.c on an x86-64
+    machine (TSC cycles, -O2 -march=native).
+*/
+
+/*! sin and cos, max error 1.2e-6 (fast) and 9.4e-9 (mid), 6 and 10 cycles.
+    The exact versions take 28 cycles.
+*/
+extern fix32_t fix32_sin_fast(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_sin_mid(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_cos_fast(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_cos_mid(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+
+/*! Computes the sine (cosine) of n angles, outValues may be inAngles.
+    When AVX2 or AVX-512 is enabled at compile time the results are within
+    1 LSB of fix32_sin (fix32_cos), otherwise they are the same.
+*/
+extern void fix32_sin_array(const fix32_t *inAngles, fix32_t *outValues, size_t n);
+extern void fix32_cos_array(const fix32_t *inAngles, fix32_t *outValues, size_t n);
+
+/*! Returns the tangent of the given fix32_t.
+*/
+extern fix32_t fix32_tan(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the arcsine of the given fix32_t.
+*/
+extern fix32_t fix32_asin(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the arccosine of the given fix32_t.
+*/
+extern fix32_t fix32_acos(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the arctangent of the given fix32_t.
+*/
+extern fix32_t fix32_atan(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the arctangent of inY/inX, accurate to 1 LSB.
+*/
+extern fix32_t fix32_atan2(fix32_t inY, fix32_t inX) FIXMATH_FUNC_ATTRS;
+
+/*! Faster, less precise versions of fix32_atan2, see the precision tiers.
+	 The maximum error is 3.7e-7 rad for the fast and 1.2e-8 rad for the mid
+	 version, 24 and 27 cycles, the exact version takes 39 cycles.
+*/
+extern fix32_t fix32_atan2_mid(fix32_t inY, fix32_t inX) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_atan2_fast(fix32_t inY, fix32_t inX) FIXMATH_FUNC_ATTRS;
+
+/* Binary angle (turns) trigonometry.
+ * The angle is an unsigned fraction of a full turn: 2^32 is one revolution
+ * for the uint32_t versions and 2^64 for the *64 versions. The top bits
+ * select the quadrant directly and wraparound is free, so the values of
+ * phase accumulators and encoders can be used as such.
+ */
+
+/*! Returns the sine of the given binary angle.
+*/
+extern fix32_t fix32_sin_turns64(uint64_t inTurns) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the cosine of the given binary angle.
+*/
+extern fix32_t fix32_cos_turns64(uint64_t inTurns) FIXMATH_FUNC_ATTRS;
+
+/*! Returns both the sine and the cosine of the given binary angle.
+*/
+extern void fix32_sincos_turns64(uint64_t inTurns, fix32_t *outSin, fix32_t *outCos);
+
+/*! Returns the angle of the vector (inX, inY) as a binary angle.
+*/
+extern uint64_t fix32_atan2_turns64(fix32_t inY, fix32_t inX) FIXMATH_FUNC_ATTRS;
+
+static inline fix32_t fix32_sin_turns(uint32_t inTurns)
+	{ return fix32_sin_turns64((uint64_t)inTurns << 32); }
+static inline fix32_t fix32_cos_turns(uint32_t inTurns)
+	{ return fix32_cos_turns64((uint64_t)inTurns << 32); }
+static inline void fix32_sincos_turns(uint32_t inTurns, fix32_t *outSin, fix32_t *outCos)
+	{ fix32_sincos_turns64((uint64_t)inTurns << 32, outSin, outCos); }
+static inline uint32_t fix32_atan2_turns(fix32_t inY, fix32_t inX)
+	{ return (uint32_t)((fix32_atan2_turns64(inY, inX) + 0x80000000) >> 32); }
+
+/* Conversions between binary angles, radians and degrees.
+ * The binary angle is treated as signed when converting from it,
+ * so the results are in [-pi, pi) and [-180, 180).
+ */
+extern fix32_t  fix32_turns64_to_rad(uint64_t inTurns) FIXMATH_FUNC_ATTRS;
+extern uint64_t fix32_rad_to_turns64(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+extern fix32_t  fix32_turns64_to_deg(uint64_t inTurns) FIXMATH_FUNC_ATTRS;
+extern uint64_t fix32_deg_to_turns64(fix32_t inAngle) FIXMATH_FUNC_ATTRS;
+
+static inline fix32_t fix32_turns_to_rad(uint32_t inTurns)
+	{ return fix32_turns64_to_rad((uint64_t)inTurns << 32); }
+static inline uint32_t fix32_rad_to_turns(fix32_t inAngle)
+	{ return (uint32_t)((fix32_rad_to_turns64(inAngle) + 0x80000000) >> 32); }
+static inline fix32_t fix32_turns_to_deg(uint32_t inTurns)
+	{ return fix32_turns64_to_deg((uint64_t)inTurns << 32); }
+static inline uint32_t fix32_deg_to_turns(fix32_t inAngle)
+	{ return (uint32_t)((fix32_deg_to_turns64(inAngle) + 0x80000000) >> 32); }
+
+static const fix32_t fix32_rad_to_deg_mult = 246101626061;
+static inline fix32_t fix32_rad_to_deg(fix32_t radians)
+	{ return fix32_mul(radians, fix32_rad_to_deg_mult); }
+
+static const fix32_t fix32_deg_to_rad_mult = 74947179;
+static inline fix32_t fix32_deg_to_rad(fix32_t degrees)
+	{ return fix32_mul(degrees, fix32_deg_to_rad_mult); }
+
+
+
+/*! Returns the square root of the given fix32_t, correctly rounded (or
+    rounded down with FIXMATH_NO_ROUNDING). Negative inputs give -sqrt(-x).
+*/
+extern fix32_t fix32_sqrt(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Precision tiers of fix32_sqrt, see fix32_sin_fast. Negative inputs give
+    -sqrt(-x) like fix32_sqrt. Max error 5.7e-6 (fast) and 2.3e-9 (mid), 8
+    and 12 cycles, the exact version takes 25 cycles.
+*/
+extern fix32_t fix32_sqrt_fast(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_sqrt_mid(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Returns 1/sqrt(x), within 1 LSB, without division. Returns
+    fix32_overflow for x <= 0.
+*/
+extern fix32_t fix32_rsqrt(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Computes fix32_sqrt (fix32_rsqrt) of n values, outValues may be
+    inValues. With AVX2 or AVX-512 enabled at compile time the square roots
+    are still the same as fix32_sqrt, and the reciprocal roots within 1 LSB
+    of the exact value like fix32_rsqrt.
+*/
+extern void fix32_sqrt_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_rsqrt_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+
+/*! Scales the vector (x, y) or (x, y, z) in place to unit length, each
+    component within 1 LSB. The sum of squares is exact in 128 bits, so any
+    component values work. The zero vector is left as it is.
+*/
+extern void fix32_normalize2(fix32_t *x, fix32_t *y);
+extern void fix32_normalize3(fix32_t *x, fix32_t *y, fix32_t *z);
+
+/*! Returns sqrt(x^2 + y^2) or sqrt(x^2 + y^2 + z^2), correctly rounded
+    (or rounded down with FIXMATH_NO_ROUNDING). The sum of squares and its
+    root are exact in 128 bits, so this does not overflow where
+    fix32_sqrt(fix32_mul(x, x) + fix32_mul(y, y)) does, from about 46341.
+    Saturates to fix32_maximum.
+*/
+extern fix32_t fix32_hypot(fix32_t x, fix32_t y) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_hypot3(fix32_t x, fix32_t y, fix32_t z) FIXMATH_FUNC_ATTRS;
+
+/*! fix32_hypot over n interleaved (x, y) pairs, inPairs holds 2 * n values.
+*/
+extern void fix32_hypot_array(const fix32_t *inPairs, fix32_t *outValues, size_t n);
+
+/*! fix32_hypot(re[i], im[i]) for n values in separate arrays, the
+    magnitudes of n complex numbers. outValues may be re or im. The results
+    are the same as fix32_hypot with or without SIMD.
+*/
+extern void fix32_magnitude_array(const fix32_t *re, const fix32_t *im, fix32_t *outValues, size_t n);
+
+/*! Returns the cube root of the given fix32_t, correctly rounded (or
+    rounded down with FIXMATH_NO_ROUNDING). Negative inputs give -cbrt(-x).
+*/
+extern fix32_t fix32_cbrt(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the square of the given fix32_t.
+*/
+static inline fix32_t fix32_sq(fix32_t x)
+	{ return fix32_mul(x, x); }
+
+/*! Returns the exponent (e^) of the given fix32_t.
+    Accurate to 1 LSB, or 2^-61 relative for results above 2^29. Saturates
+    to fix32_maximum for inputs above ln(2^31).
+*/
+extern fix32_t fix32_exp(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Returns e^x - 1. |x| < 0.5 takes a short polynomial without range
+    reduction. Accurate to 1 LSB, or 2^-61 relative for results above 2^29,
+    and saturates like fix32_exp.
+*/
+extern fix32_t fix32_expm1(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the natural logarithm of the given fix32_t, accurate to 1 LSB.
+    Returns fix32_minimum for inputs <= 0.
+ */
+extern fix32_t fix32_ln(fix32_t inValue) FIXMATH_FUNC_ATTRS;
+
+/*! Returns ln(1 + x), accurate to 1 LSB and also defined where 1 + x
+    overflows. Returns fix32_minimum for x <= -1.
+ */
+extern fix32_t fix32_log1p(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the base 10 logarithm, accurate to 1 LSB.
+    Returns fix32_minimum for inputs <= 0.
+ */
+extern fix32_t fix32_log10(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns 10^x. Accurate to 1 LSB, or 2^-60 relative for results above
+    2^29, and saturates to fix32_maximum.
+ */
+extern fix32_t fix32_exp10(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Decibel conversions: 10 * log10(x) of a power ratio, 20 * log10(x) of
+    an amplitude ratio, and the amplitude ratio 10^(db/20) back. There is
+    no division; accuracy and limits are those of fix32_log10 and
+    fix32_exp10, and x <= 0 gives fix32_minimum.
+    For a power ratio from decibels use fix32_exp10(db / 10).
+ */
+extern fix32_t fix32_to_db_power(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_to_db_amplitude(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_from_db(fix32_t db) FIXMATH_FUNC_ATTRS;
+
+/*! Apply the functions above to n values, outValues may be inValues. */
+extern void fix32_log10_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_exp10_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_to_db_power_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_to_db_amplitude_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_from_db_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+
+/*! Returns the base 2 logarithm of the given fix32_t, accurate to 1 LSB.
+    Returns fix32_overflow for inputs <= 0.
+ */
+extern fix32_t fix32_log2(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the saturated base 2 logarithm of the given fix32_t.
+ */
+extern fix32_t fix32_slog2(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns 2 raised to the specified power, accurate to 1 LSB, or 2^-61
+ * relative for results above 2^29. Saturates to fix32_maximum from 2^31.
+ */
+extern fix32_t fix32_pow2(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns a specified number raised to the specified power.
+ * Accurate to 1 LSB plus 2^-50 relative, which is below the effect of the
+ * LSB of exp on large results. Saturates to fix32_maximum.
+ * Returns fix32_overflow for negative b.
+ */
+extern fix32_t fix32_pow(fix32_t b, fix32_t exp) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the saturated version of fix32_pow; negative b gives fix32_minimum.
+ */
+extern fix32_t fix32_spow(fix32_t b, fix32_t exp) FIXMATH_FUNC_ATTRS;
+
+/*! Precision tiers of fix32_exp, fix32_ln, fix32_log2 and fix32_pow2, see
+ * fix32_sin_fast. They saturate and handle x <= 0 like the exact versions.
+ *   exp:  max error 3.5e-6 (fast) and 4.4e-9 (mid), 14 and 15 cycles, exact 31
+ *   pow2: max error 3.5e-6 and 4.2e-9, 12 and 12 cycles, exact 25
+ *   ln:   max error 4.1e-6 and 2.4e-9, 7 and 9 cycles, exact 20
+ *   log2: max error 5.9e-6 and 2.9e-9, 7 and 8 cycles, exact 23
+ */
+extern fix32_t fix32_exp_fast(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_exp_mid(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_ln_fast(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_ln_mid(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_log2_fast(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_log2_mid(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_pow2_fast(fix32_t x) FIXMATH_FUNC_ATTRS;
+extern fix32_t fix32_pow2_mid(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Computes fix32_exp (fix32_ln, fix32_log2, fix32_pow2) of n values,
+ * outValues may be inValues. When AVX2 or AVX-512 is enabled at compile
+ * time the logarithms are within 1 LSB of the scalar functions, and the
+ * exponentials within 1 LSB or 2^-50 relative, whichever is larger.
+ * Otherwise the results are the same.
+ */
+extern void fix32_exp_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_ln_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_log2_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_pow2_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+
+/*! Returns base raised to the integer power n, by squaring and multiplying.
+ * Negative bases and negative n are allowed, 0^n for n < 0 overflows.
+ * The intermediates keep 64 significant bits and the result is rounded
+ * once, so small powers are exact when representable. The error is within
+ * 0.5 LSB plus |n| * 2^-64 relative, far below the effect of the LSB of
+ * base. Returns fix32_overflow when out of range.
+ */
+extern fix32_t fix32_powi(fix32_t base, int n) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the saturated version of fix32_powi.
+ */
+extern fix32_t fix32_spowi(fix32_t base, int n) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the n-th root of x for an integer n >= 1, within 1 LSB. Odd n
+ * allow negative x, which give -rootn(-x, n). Returns fix32_overflow for
+ * n <= 0 and for negative x with even n. n = 2 and 3 are fix32_sqrt and
+ * fix32_cbrt. fix32_pow(x, 1/n) costs about the same for larger n, but is
+ * off by up to several hundred LSB, as 1/n is not exact in Q32.
+ */
+extern fix32_t fix32_rootn(fix32_t x, int n) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the hyperbolic tangent of x, accurate to 1 LSB.
+ */
+extern fix32_t fix32_tanh(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the logistic function 1 / (1 + e^-x), accurate to 1 LSB.
+ */
+extern fix32_t fix32_sigmoid(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns ln(1 + e^x), accurate to 1 LSB.
+ */
+extern fix32_t fix32_softplus(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Returns the Gaussian error linear unit x * Phi(x), where Phi is the
+ * standard normal distribution function. This is the exact form, not the
+ * tanh approximation, and is accurate to 1 LSB.
+ */
+extern fix32_t fix32_gelu(fix32_t x) FIXMATH_FUNC_ATTRS;
+
+/*! Apply the activation functions above to n values, e.g. a whole layer.
+ * outValues may be inValues.
+ */
+extern void fix32_tanh_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_sigmoid_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_softplus_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+extern void fix32_gelu_array(const fix32_t *inValues, fix32_t *outValues, size_t n);
+
+/*! Converts the value to a decimal string with the given number of
+ * decimals (0 to 32, 32 is exact), rounded to nearest, ties to even, like
+ * printf. The longest string, including the terminator, is 45 bytes.
+ */
+extern void fix32_to_str(fix32_t value, char *buf, int decimals);
+
+/*! Converts a decimal string to fix32_t, correctly rounded (truncated with
+ * FIXMATH_NO_ROUNDING) however many decimals there are. Ignores
+ * spaces at the beginning and end and accepts '.' or ',' as the decimal
+ * point. Returns fix32_overflow if the value is too large or there were
+ * garbage characters.
+ */
+extern fix32_t fix32_from_str(const char *buf);
+
+/*! Converts fix32_t to the shortest decimal string that fix32_from_str
+ * converts back to the same value, and of those the closest one. Whole
+ * numbers have no decimal point. The longest string, including the
+ * terminator, is 23 bytes.
+ */
+extern void fix32_to_str_shortest(fix32_t value, char *buf);
+
+/*! Writes the values as fix32_to_str_shortest strings, separated by delim,
+ * into the size bytes at buf and returns how many were written. Stops
+ * before the first value that does not fit with a terminator. The result
+ * is terminated unless size is 0, and *length, when not NULL, receives
+ * its length without the terminator.
+ */
+extern size_t fix32_format_array(const fix32_t *values, size_t count, char *buf, size_t size, char delim,
+	size_t *length);
+
+/*! Parses up to cap numbers from the len bytes at buf into out and returns
+ * how many it stored. The numbers are separated by delim or line breaks
+ * and may be surrounded by spaces and tabs, a separator at the very end is
+ * allowed. The format is that of fix32_from_str, with '.' as the only
+ * decimal point, and the results are the same. Parsing stops at the first
+ * malformed or out of range entry, or at an entry that does not fit into
+ * out. *stopOffset, when not NULL, receives the offset where it stopped,
+ * which is len if the whole buffer was parsed.
+ */
+extern size_t fix32_parse_buffer(const char *buf, size_t len, fix32_t *out, size_t cap, char delim,
+	size_t *stopOffset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,265 +1,971 @@
-#include "fix32.h"
-#include <stdbool.h>
-
-
-fix32_t fix32_exp(fix32_t inValue) {
-	if(inValue == 0          ) return fix32_one;
-	if(inValue == fix32_one  ) return fix32_e;
-	if(inValue >= 92288378626I64) return fix32_maximum;	//fix32_from_dbl(ln(fix32_to_dbl(fix32_maximum))) = fix32_from_dbl(ln(2147483648)) = fix32_from_dbl(21.487562597) = 92288378625
-	if(inValue <= -98242467570I64) return 0;			//fix32_from_dbl(ln(fix32_to_dbl(fix32_epsilon))) = fix32_from_dbl(ln(0.00000000023283064365)) = fix32_from_dbl(-22.1807097779) = -95265423098
-														//fix32_from_dbl(ln(0.5*fix32_to_dbl(fix32_epsilon))) = fix32_from_dbl(ln(0.000000000116415321825)) = fix32_from_dbl(-22.87385) = -98242467570
-
-                        
-	/* The algorithm is based on the power series for exp(x):
-	 * http://en.wikipedia.org/wiki/Exponential_function#Formal_definition
-	 * 
-	 * From term n, we get term n+1 by multiplying with x/n.
-	 * When the sum term drops to zero, we can stop summing.
-	 */
-            
-	// The power-series converges much faster on positive values
-	// and exp(-x) = 1/exp(x).
-	bool neg = (inValue < 0);
-	if (neg) inValue = -inValue;
-
-	fix32_t result = inValue + fix32_one;
-	fix32_t term = inValue;
-
-	uint_fast8_t i;
-	for (i = 2; i < 30; i++)
-	{
-		term = fix32_mul(term, fix32_div(inValue, fix32_from_int(i)));
-		result += term;
-
-		if ((term < 500) && ((i > 15) || (term < 20)))
-			break;
-	}
-
-	if (neg)
-		result = fix32_div(fix32_one, result);
-
-	return result;
-}
-
-
-
-fix32_t fix32_ln(fix32_t inValue)
-{
-	fix32_t guess = fix32_from_int(2);
-	fix32_t delta;
-	int scaling = 0;
-	int count = 0;
-	
-	if (inValue <= 0)
-		return fix32_minimum;
-	
-	// Bring the value to the most accurate range (1 < x < 100)
-	const fix32_t e_to_fourth = 234497268814;
-	while (inValue > fix32_from_int(100))
-	{
-		inValue = fix32_div(inValue, e_to_fourth);
-		scaling += 4;
-	}
-	
-	while (inValue < fix32_one)
-	{
-		inValue = fix32_mul(inValue, e_to_fourth);
-		scaling -= 4;
-	}
-	
-	do
-	{
-		// Solving e(x) = y using Newton's method
-		// f(x) = e(x) - y
-		// f'(x) = e(x)
-		fix32_t e = fix32_exp(guess);
-		delta = fix32_div(inValue - e, e);
-		
-		// It's unlikely that logarithm is very large, so avoid overshooting.
-		if (delta > fix32_from_int(3))
-			delta = fix32_from_int(3);
-		
-		guess += delta;
-	} while ((count++ < 10)
-		&& ((delta > 1) || (delta < -1)));
-	
-	return guess + fix32_from_int(scaling);
-}
-
-
-
-static inline fix32_t fix32_rs(fix32_t x)
-{
-	#ifdef FIXMATH_NO_ROUNDING
-		return (x >> 1);
-	#else
-		fix32_t y = (x >> 1) + (x & 1);
-		return y;
-	#endif
-}
-
-/**
- * This assumes that the input value is >= 1.
- * 
- * Note that this is only ever called with inValue >= 1 (because it has a wrapper to check. 
- * As such, the result is always less than the input. 
- */
-static fix32_t fix32__log2_inner(fix32_t x)
-{
-	fix32_t result = 0;
-	
-	while(x >= fix32_from_int(2))
-	{
-		result++;
-		x = fix32_rs(x);
-	}
-
-	if(x == 0) return (result << 32);
-
-	uint_fast8_t i;
-	for(i = 32; i > 0; i--)
-	{
-		x = fix32_mul(x, x);
-		result <<= 1;
-		if(x >= fix32_from_int(2))
-		{
-			result |= 1;
-			x = fix32_rs(x);
-		}
-	}
-	#ifndef FIXMATH_NO_ROUNDING
-		x = fix32_mul(x, x);
-		if(x >= fix32_from_int(2)) result++;
-	#endif
-	
-	return result;
-}
-
-
-
-/**
- * calculates the log base 2 of input.
- * Note that negative inputs are invalid! (will return fix32_overflow, since there are no exceptions)
- * 
- * i.e. 2 to the power output = input.
- * It's equivalent to the log or ln functions, except it uses base 2 instead of base 10 or base e.
- * This is useful as binary things like this are easy for binary devices, like modern microprocessros, to calculate.
- * 
- * This can be used as a helper function to calculate powers with non-integer powers and/or bases.
- */
-fix32_t fix32_log2(fix32_t x)
-{
-	// Note that a negative x gives a non-real result.
-	// If x == 0, the limit of log2(x)  as x -> 0 = -infinity.
-	// log2(-ve) gives a complex result.
-	if (x <= 0) return fix32_overflow;
-
-	// If the input is less than one, the result is -log2(1.0 / in)
-	if (x < fix32_one)
-	{
-		// Note that the inverse of this would overflow.
-		// This is the exact answer for log2(1.0 / 4294967296)
-		if (x == 1) return fix32_from_int(-32);
-
-		fix32_t inverse = fix32_div(fix32_one, x);
-		return -fix32__log2_inner(inverse);
-	}
-
-	// If input >= 1, just proceed as normal.
-	// Note that x == fix32_one is a special case, where the answer is 0.
-	return fix32__log2_inner(x);
-}
-
-/**
- * This is a wrapper for fix32_log2 which implements saturation arithmetic.
- */
-fix32_t fix32_slog2(fix32_t x)
-{
-	fix32_t retval = fix32_log2(x);
-	// The only overflow possible is when the input is negative.
-	if(retval == fix32_overflow)
-		return fix32_minimum;
-	return retval;
-}
-
-fix32_t fix32_pow2(fix32_t x)
-{
-	const static fix32_t LN2 =	    0x00000000B17217F7;
-	const static fix32_t Log2Max =  0x0000001F00000000;
-	const static fix32_t Log2Min = -0x0000002000000000;
-
-	if (x == 0)
-		return fix32_one;
-
-	// Avoid negative arguments by exploiting that exp(-x) = 1/exp(x).
-	bool neg = x < 0;
-	if (neg)
-		x = -x;
-
-	if (x == fix32_one)
-	{
-		return neg ? 0x0000000080000000 : 0x0000000200000000;
-		//return neg ? fix32_from_double(0.5) : fix32_from_int(2);
-	}
-	if (x >= Log2Max)
-	{
-		return neg ? fix32_epsilon : fix32_maximum;
-	}
-	if (x <= Log2Min)
-	{
-		return neg ? fix32_maximum : 0;
-	}
-
-	/* The algorithm is based on the power series for exp(x):
-	 * http://en.wikipedia.org/wiki/Exponential_function#Formal_definition
-	 *
-	 * From term n, we get term n+1 by multiplying with x/n.
-	 * When the sum term drops to zero, we can stop summing.
-	 */
-
-	fix32_t int_part = fix32_floor(x);
-	int integerPart = (int)(int_part >> 32);
-	// Take fractional part of exponent
-	x = x & 0x00000000FFFFFFFF;
-
-	fix32_t result = fix32_one;
-	fix32_t term = fix32_one;
-	int i = 1;
-	while (term != 0)
-	{
-		term = fix32_mul(term, fix32_mul(LN2, fix32_div(x, fix32_from_int(i))));
-		result += term;
-		i++;
-	}
-
-	result = result << integerPart;
-
-	if (neg)
-		result = fix32_div(fix32_one, result);
-
-	return result;
-}
-
-fix32_t fix32_pow(fix32_t b, fix32_t exp)
-{
-	if (b == fix32_one || exp == 0)
-		return fix32_one;
-
-	if (b == 0)
-		return 0;
-
-	fix32_t log2 = fix32_log2(b);
-	return fix32_pow2(fix32_mul(exp, log2));
-}
-
-fix32_t fix32_spow(fix32_t b, fix32_t exp)
-{
-	if (b == fix32_one || exp == 0)
-		return fix32_one;
-
-	if (b == 0)
-		return 0;
-
-	fix32_t log2 = fix32_slog2(b);
-	return fix32_pow2(fix32_smul(exp, log2));
-}
\ No newline at end of file
+#include "fix32.h"
+#include "fix32_internal.h"
+#include <stdbool.h>
+
+
+/* 2^(j/64) for j = 0..63, in unsigned Q63. */
+static const uint64_t _fix32_exp2_table[64] = {
+	0x8000000000000000, 0x8164D1F3BC030773, 0x82CD8698AC2BA1D7, 0x843A28C3ACDE4046,
+	0x85AAC367CC487B15, 0x871F61969E8D1010, 0x88980E8092DA8527, 0x8A14D575496EFD9A,
+	0x8B95C1E3EA8BD6E7, 0x8D1ADF5B7E5BA9E6, 0x8EA4398B45CD53C0, 0x9031DC431466B1DC,
+	0x91C3D373AB11C336, 0x935A2B2F13E6E92C, 0x94F4EFA8FEF70961, 0x96942D3720185A00,
+	0x9837F0518DB8A96F, 0x99E0459320B7FA65, 0x9B8D39B9D54E5539, 0x9D3ED9A72CFFB751,
+	0x9EF5326091A111AE, 0xA0B0510FB9714FC2, 0xA27043030C496819, 0xA43515AE09E6809E,
+	0xA5FED6A9B15138EA, 0xA7CD93B4E965356A, 0xA9A15AB4EA7C0EF8, 0xAB7A39B5A93ED337,
+	0xAD583EEA42A14AC6, 0xAF3B78AD690A4375, 0xB123F581D2AC2590, 0xB311C412A9112489,
+	0xB504F333F9DE6484, 0xB6FD91E328D17791, 0xB8FBAF4762FB9EE9, 0xBAFF5AB2133E45FB,
+	0xBD08A39F580C36BF, 0xBF1799B67A731083, 0xC12C4CCA66709456, 0xC346CCDA24976407,
+	0xC5672A115506DADD, 0xC78D74C8ABB9B15D, 0xC9B9BD866E2F27A3, 0xCBEC14FEF2727C5D,
+	0xCE248C151F8480E4, 0xD06333DAEF2B2595, 0xD2A81D91F12AE45A, 0xD4F35AABCFEDFA1F,
+	0xD744FCCAD69D6AF4, 0xD99D15C278AFD7B6, 0xDBFBB797DAF23755, 0xDE60F4825E0E9124,
+	0xE0CCDEEC2A94E111, 0xE33F8972BE8A5A51, 0xE5B906E77C8348A8, 0xE8396A503C4BDC68,
+	0xEAC0C6E7DD24392F, 0xED4F301ED9942B84, 0xEFE4B99BDCDAF5CB, 0xF281773C59FFB13A,
+	0xF5257D152486CC2C, 0xF7D0DF730AD13BB9, 0xFA83B2DB722A033A, 0xFD3E0C0CF486C175
+	};
+
+/* Taylor coefficients 1/n! of exp(r) - 1 for n = 2..6, in Q62. */
+static const int64_t _fix32_expm1_poly[5] = {
+	0x2000000000000000, 0x0AAAAAAAAAAAAAAB, 0x02AAAAAAAAAAAAAB, 0x0088888888888889,
+	0x0016C16C16C16C17
+	};
+
+static const int64_t  FIX32_64_DIV_LN2_Q56 = 0x5C551D94AE0BF85E; /*!< 64/ln(2) in Q56 */
+static const uint64_t FIX32_LN2_DIV_64_Q64 = 0x02C5C85FDF473DE6; /*!< ln(2)/64 in Q64 ... */
+static const uint64_t FIX32_LN2_DIV_64_LO  = 0xAF278ECE;         /*!< ... and the next 32 bits */
+
+/* Returns 2^(j/64) * exp(r) in unsigned Q63, for |r| <= ln(2)/128 in Q64.
+ * 2^(j/64) comes from the table and exp(r) - 1 needs only six terms of
+ * the Taylor series on that interval. The result is in [0.99, 2) and has
+ * a relative error below 2^-61.
+ */
+static uint64_t fix32__exp_mantissa(int j, int64_t r)
+{
+	// exp(r) - 1 = r + r^2/2 + ... + r^6/720, in Q70.
+	int64_t p = _fix32_expm1_poly[4];
+	int i;
+	for (i = 3; i >= 0; i--)
+		p = _fix32_expm1_poly[i] + fix32__mul_shr(p, r, 64);
+	p = ((int64_t)1 << 62) + fix32__mul_shr(p, r, 64);
+	int64_t expm1 = fix32__mul_shr(p, r, 56);
+
+	uint64_t table = _fix32_exp2_table[j];
+	return (expm1 >= 0)
+		? table + fix32__umul_shr(table, (uint64_t)expm1, 70)
+		: table - fix32__umul_shr(table, -(uint64_t)expm1, 70);
+}
+
+/* Returns 2^(n/64) * exp(r) in Q32, rounded, for |r| <= ln(2)/128 in Q64.
+ * Saturates to fix32_maximum.
+ */
+static fix32_t fix32__exp_reduced(int64_t n, int64_t r)
+{
+	int k = (int)(n >> 6);
+	uint64_t mantissa = fix32__exp_mantissa((int)(n & 63), r);
+
+	// Q63 to Q32 with the power of two, rounded.
+	int shift = 31 - k;
+	if (shift <= 0)
+		return (shift < 0 || (mantissa >> 63)) ? fix32_maximum : (fix32_t)mantissa;
+	if (shift > 64)
+		return 0;
+	return (fix32_t)(((mantissa >> (shift - 1)) + 1) >> 1);
+}
+
+/* Returns r = x - n * ln(2)/64 in Q64, for x in Q64 modulo 2^64 and
+ * |n| < 2^22. The terms wrap around, but r is small.
+ */
+static int64_t fix32__exp_rem(int64_t n, uint64_t x)
+{
+	return (int64_t)(x
+		- (uint64_t)n * FIX32_LN2_DIV_64_Q64
+		- (uint64_t)((n * (int64_t)FIX32_LN2_DIV_64_LO) >> 32));
+}
+
+/* Splits x = n * ln(2)/64 + r and returns n, with r in Q64 and
+ * |r| <= ln(2)/128. The reduction uses ln(2)/64 to 96 bits, so r is exact
+ * to 2^-64. Valid for |x| < 2^16.
+ */
+static int64_t fix32__exp_split(fix32_t x, int64_t *r)
+{
+	// n = round(x * 64 / ln(2)) = 64k + j
+	int64_t n = (fix32__mul_shr(x, FIX32_64_DIV_LN2_Q56, 87) + 1) >> 1;
+	*r = fix32__exp_rem(n, (uint64_t)x << 32);
+	return n;
+}
+
+/* Returns exp(x) in unsigned Q63, rounded, for -44 < x <= 0. */
+static uint64_t fix32__exp_neg_q63(fix32_t x)
+{
+	int64_t r;
+	int64_t n = fix32__exp_split(x, &r);
+	uint64_t mantissa = fix32__exp_mantissa((int)(n & 63), r);
+
+	int shift = (int)-(n >> 6);
+	if (shift == 0)
+		return mantissa;
+	return ((mantissa >> (shift - 1)) + 1) >> 1;
+}
+
+/* The exponential is computed as exp(x) = 2^k * 2^(j/64) * exp(r), where
+ * x = (64k + j) * ln(2)/64 + r and |r| <= ln(2)/128. There are no loops or
+ * divisions, and the result is within 1 LSB, or 2^-61 relative for
+ * results above 2^29.
+ */
+fix32_t fix32_exp(fix32_t inValue)
+{
+	if(inValue >= 92288378626LL) return fix32_maximum;	//fix32_from_dbl(ln(fix32_to_dbl(fix32_maximum))) = fix32_from_dbl(ln(2147483648)) = fix32_from_dbl(21.487562597) = 92288378625
+	if(inValue <= -98242467570LL) return 0;			//fix32_from_dbl(ln(0.5*fix32_to_dbl(fix32_epsilon))) = fix32_from_dbl(ln(0.000000000116415321825)) = fix32_from_dbl(-22.87385) = -98242467570
+
+	int64_t r;
+	int64_t n = fix32__exp_split(inValue, &r);
+	return fix32__exp_reduced(n, r);
+}
+
+/* Minimax polynomial for (exp(x) - 1) / x on [-0.5, 0.5], in Q62, lowest
+ * order first. The error of exp(x) - 1 is below 2^-39.
+ */
+static const int64_t _fix32_expm1_small[9] = {
+	0x4000000000000000, 0x1FFFFFFFF58D9405, 0x0AAAAAAAA9B7B25B, 0x02AAAAACD7C2423F,
+	0x00888888BB25602C, 0x0016C14CC3B4AE7C, 0x000340312AAA3F9D, 0x000068AD6A778F2E,
+	0x00000B9E1CAD0293
+	};
+
+/* Small arguments take the polynomial above without any reduction.
+ * Negative ones subtract 1 from exp(x) in Q63 before rounding, and
+ * positive ones from 0.5 on go through fix32_exp.
+ */
+fix32_t fix32_expm1(fix32_t x)
+{
+	if (x > -(fix32_one >> 1) && x < (fix32_one >> 1))
+	{
+		int64_t s = x * ((int64_t)1 << 30);
+		int64_t p = _fix32_expm1_small[8];
+		int i;
+		for (i = 7; i >= 0; i--)
+			p = _fix32_expm1_small[i] + fix32__mul_shr(p, s, 62);
+		return (fix32__mul_shr(p, s, 62) + ((int64_t)1 << 29)) >> 30;
+	}
+
+	if (x < 0)
+	{
+		// exp(x) is below 2^-34 from -24 on.
+		if (x <= -fix32_from_int(24))
+			return -fix32_one;
+		int64_t result = (int64_t)(fix32__exp_neg_q63(x) - ((uint64_t)1 << 63));
+		return (result + ((int64_t)1 << 30)) >> 31;
+	}
+
+	fix32_t result = fix32_exp(x);
+	return (result == fix32_maximum ? fix32_maximum : result - fix32_one);
+}
+
+
+/* Reciprocals 1/c of the centres c = 1 + (i + 1/2)/64 of the mantissa
+ * intervals, in unsigned Q64, and -ln of those reciprocals in Q62.
+ */
+static const uint64_t _fix32_ln_recip[64] = {
+	0xFE03F80FE03F80FE, 0xFA232CF252138AC0, 0xF6603D980F6603DA, 0xF2B9D6480F2B9D65,
+	0xEF2EB71FC4345238, 0xEBBDB2A5C1619C8C, 0xE865AC7B7603A197, 0xE525982AF70C880E,
+	0xE1FC780E1FC780E2, 0xDEE95C4CA037BA57, 0xDBEB61EED19C5958, 0xD901B2036406C80E,
+	0xD62B80D62B80D62C, 0xD3680D3680D3680D, 0xD0B69FCBD2580D0B, 0xCE168A7725080CE1,
+	0xCB8727C065C393E0, 0xC907DA4E871146AD, 0xC6980C6980C6980C, 0xC4372F855D824CA6,
+	0xC1E4BBD595F6E947, 0xBFA02FE80BFA02FF, 0xBD69104707661AA3, 0xBB3EE721A54D880C,
+	0xB92143FA36F5E02E, 0xB70FBB5A19BE3659, 0xB509E68A9B94821F, 0xB30F63528917C80B,
+	0xB11FD3B80B11FD3C, 0xAF3ADDC680AF3ADE, 0xAD602B580AD602B6, 0xAB8F69E28359CD11,
+	0xA9C84A47A07F5638, 0xA80A80A80A80A80B, 0xA655C4392D7B73A8, 0xA4A9CF1D96833751,
+	0xA3065E3FAE7CD0E0, 0xA16B312EA8FC377D, 0x9FD809FD809FD80A, 0x9E4CAD23DD5F3A20,
+	0x9CC8E160C3FB19B9, 0x9B4C6F9EF03A3CAA, 0x99D722DABDE58F06, 0x9868C809868C8098,
+	0x97012E025C04B809, 0x95A02568095A0257, 0x9445809445809446, 0x92F113840497889C,
+	0x91A2B3C4D5E6F809, 0x905A38633E06C43B, 0x8F1779D9FDC3A219, 0x8DDA520237694809,
+	0x8CA29C046514E023, 0x8B70344A139BC75A, 0x8A42F8705669DB46, 0x891AC73AE9819B50,
+	0x87F78087F78087F8, 0x86D905447A34ACC6, 0x85BF37612CEE3C9B, 0x84A9F9C8084A9F9D,
+	0x839930523FBE3368, 0x828CBFBEB9A020A3, 0x81848DA8FAF0D277, 0x8080808080808081
+	};
+static const int64_t _fix32_ln_table[64] = {
+	0x007F80A9AC419E24, 0x017B91B07D5B11AA, 0x0273D0F73FD7ABF5, 0x03685BAE232E37D8,
+	0x04594DBBA8DEB83A, 0x0546C1CFC1860FDA, 0x0630D1758C66C83D, 0x07179523D6F1D0C6,
+	0x07FB244C76FAAEAB, 0x08DB956A97B3D015, 0x09B8FE100F47BA1E, 0x0A9372F1D0DA1BD1,
+	0x0B6B07F38CE90E47, 0x0C3FD03290648848, 0x0D11DE0FF15AB18D, 0x0DE1433A16C66B15,
+	0x0EAE10B5A7DDC8AE, 0x0F7856E5EE2C9B29, 0x10402594B4D040DB, 0x11058BF9AE4AD518,
+	0x11C898C16999FAFC, 0x12895A13DE86A35F, 0x1347DD9A987D54D6, 0x1404308686A7E3BD,
+	0x14BE5F957778A0DB, 0x15767717455A6C54, 0x162C82F2B9C7952F, 0x16E08EAA2BA1E38C,
+	0x1792A55FDD47A27C, 0x1842D1DA1E8B1749, 0x18F11E873662C77E, 0x199D958117E08ACC,
+	0x1A484090E5BB0A2C, 0x1AF1293247786B11, 0x1B9858969310FB59, 0x1C3DD7A7CDAD4D74,
+	0x1CE1AF0B85F3EB7C, 0x1D83E7258A2F3E50, 0x1E24881A7C6C261D, 0x1EC399D2468CC017,
+	0x1F6123FA7028AC61, 0x1FFD2E0857F49856, 0x2097BF3B524DA4CC, 0x2130DE9EAE6A4172,
+	0x21C8930BA39917EE, 0x225EE32B27DF78A6, 0x22F3D577B133417F, 0x2387703EE2784979,
+	0x2419B9A32556DB27, 0x24AAB79D31EF9678, 0x253A6FFD85611591, 0x25C8E86DC804D081,
+	0x26562672243AE264, 0x26E22F6A8E8F6B8C, 0x276D0893FFF8455F, 0x27F6B709A2DE84B7,
+	0x287F3FC5F39CCEF5, 0x2906A7A3D511BEE8, 0x298CF35F99DC7363, 0x2A12279802D0D697,
+	0x2A9648CF33292F52, 0x2B195B6B9AF31261, 0x2B9B63B8D82EC91A, 0x2C1C65E88F11B195
+	};
+
+/* Minimax polynomial for ln(1 + z) on |z| <= 1/128, Q62, lowest order
+ * (z^1) first. The error is below 5e-18.
+ */
+static const int64_t _fix32_log1p_poly[6] = {
+	0x4000000000004128, -0x2000000000000824, 0x15555554D3CAB769, -0x0FFFFFFFCF6BD91A,
+	0x0CCD0D2F76F99C98, -0x0AAAD2E85DB50BB3
+	};
+
+static const int64_t FIX32_LN2_Q58     = 0x02C5C85FDF473DE7; /*!< ln(2) in Q58 */
+static const int64_t FIX32_LOG2_E_Q61 = 0x2E2A8ECA5705FC2F; /*!< 1/ln(2) in Q61 */
+static const int64_t FIX32_LN2_Q63    = 0x58B90BFBE8E7BCD6; /*!< ln(2) in Q63 */
+
+/* Returns ln(m) in Q62 for a mantissa m = [1, 2) in unsigned Q63.
+ * The top six fraction bits of m select the interval, and multiplying by
+ * the reciprocal of its centre leaves 1 + z with |z| < 1/128, so that
+ * ln(m) = -ln(1/c) + ln(1 + z) needs no division.
+ */
+static int64_t fix32__ln_mantissa(uint64_t m)
+{
+	unsigned i = (m >> 57) & 63;
+	int64_t z = (int64_t)(fix32__umul_shr(m, _fix32_ln_recip[i], 64) - ((uint64_t)1 << 63));
+
+	int64_t p = _fix32_log1p_poly[5];
+	int k;
+	for (k = 4; k >= 0; k--)
+		p = _fix32_log1p_poly[k] + fix32__mul_shr(p, z, 63);
+
+	return _fix32_ln_table[i] + fix32__mul_shr(p, z, 63);
+}
+
+/* ln(x) = e * ln(2) + ln(m), where x = m * 2^e and m = [1, 2) comes from
+ * normalizing x with clz. The result is within 1 LSB (5e-18 before the
+ * final rounding), in constant time.
+ */
+static fix32_t fix32__ln_unsigned(uint64_t x)
+{
+	int shift = clz(x);
+	int64_t e = 31 - shift;
+	int64_t result = e * FIX32_LN2_Q58 + (fix32__ln_mantissa(x << shift) >> 4);
+
+	return (result + ((int64_t)1 << 25)) >> 26;
+}
+
+fix32_t fix32_ln(fix32_t inValue)
+{
+	if (inValue <= 0)
+		return fix32_minimum;
+
+	return fix32__ln_unsigned((uint64_t)inValue);
+}
+
+/* 1 + x is exact in Q32, and in unsigned arithmetic it does not overflow
+ * either, so ln(1 + x) loses nothing for small x. A direct polynomial on
+ * |x| < 0.5 would need about 18 terms because of the pole at -1, the
+ * table in the mantissa kernel is cheaper.
+ */
+fix32_t fix32_log1p(fix32_t x)
+{
+	if (x <= -fix32_one)
+		return fix32_minimum;
+
+	return fix32__ln_unsigned((uint64_t)x + (uint64_t)fix32_one);
+}
+
+
+
+/**
+ * calculates the log base 2 of input.
+ * Note that negative inputs are invalid! (will return fix32_overflow, since there are no exceptions)
+ * 
+ * i.e. 2 to the power output = input.
+ * It's equivalent to the log or ln functions, except it uses base 2 instead of base 10 or base e.
+ * This is useful as binary things like this are easy for binary devices, like modern microprocessros, to calculate.
+ * 
+ * This can be used as a helper function to calculate powers with non-integer powers and/or bases.
+ */
+fix32_t fix32_log2(fix32_t x)
+{
+	// Note that a negative x gives a non-real result.
+	// If x == 0, the limit of log2(x)  as x -> 0 = -infinity.
+	// log2(-ve) gives a complex result.
+	if (x <= 0) return fix32_overflow;
+
+	// The integer part comes from the position of the leading one, and the
+	// fraction is log2 of the normalized mantissa, so inputs below one need
+	// no inversion. The result is within 1 LSB.
+	int shift = clz((uint64_t)x);
+	int64_t log2_m = fix32__mul_shr(fix32__ln_mantissa((uint64_t)x << shift), FIX32_LOG2_E_Q61, 61);
+
+	return fix32_from_int(31 - shift) + ((log2_m + ((int64_t)1 << 29)) >> 30);
+}
+
+/**
+ * This is a wrapper for fix32_log2 which implements saturation arithmetic.
+ */
+fix32_t fix32_slog2(fix32_t x)
+{
+	fix32_t retval = fix32_log2(x);
+	// The only overflow possible is when the input is negative.
+	if(retval == fix32_overflow)
+		return fix32_minimum;
+	return retval;
+}
+
+/* Returns 2^y for y in Q57, |y| < 64. y = n/64 + f with |f| <= 1/128 is
+ * split exactly, and the fraction goes to fix32__exp_reduced as f * ln(2).
+ */
+static fix32_t fix32__pow2_q57(int64_t y)
+{
+	int64_t n = (y + ((int64_t)1 << 50)) >> 51;
+	int64_t f = y - (int64_t)((uint64_t)n << 51);
+	return fix32__exp_reduced(n, fix32__mul_shr(f, FIX32_LN2_Q63, 56));
+}
+
+/* Powers of two below 2^-33 round to zero, and from 2^31 on saturate.
+ * Negative exponents need no division, they only shift further.
+ */
+fix32_t fix32_pow2(fix32_t x)
+{
+	if (x >= fix32_from_int(31))
+		return fix32_maximum;
+	if (x < fix32_from_int(-34))
+		return 0;
+
+	return fix32__pow2_q57(x * ((int64_t)1 << 25));
+}
+
+/* b^e = 2^(e * log2(b)), with log2(b) from the mantissa kernel in Q57,
+ * so that the product keeps about 53 bits even for large exponents.
+ */
+static fix32_t fix32__pow(fix32_t b, fix32_t exp)
+{
+	int shift = clz((uint64_t)b);
+	int64_t log2_b = (int64_t)((uint64_t)(31 - shift) << 57)
+		+ (fix32__mul_shr(fix32__ln_mantissa((uint64_t)b << shift), FIX32_LOG2_E_Q61, 61) >> 5);
+
+	// Range check on the product in Q26 first, it fits in Q57 below 64.
+	int64_t y = fix32__mul_shr(exp, log2_b, 63);
+	if (y >= ((int64_t)31 << 26))
+		return fix32_maximum;
+	if (y < -((int64_t)34 << 26))
+		return 0;
+
+	return fix32__pow2_q57(fix32__mul_shr(exp, log2_b, 32));
+}
+
+fix32_t fix32_pow(fix32_t b, fix32_t exp)
+{
+	if (b == fix32_one || exp == 0)
+		return fix32_one;
+
+	if (b == 0)
+		return 0;
+
+	// Negative bases give a non-real result.
+	if (b < 0)
+		return fix32_overflow;
+
+	return fix32__pow(b, exp);
+}
+
+fix32_t fix32_spow(fix32_t b, fix32_t exp)
+{
+	if (b == fix32_one || exp == 0)
+		return fix32_one;
+
+	if (b == 0)
+		return 0;
+
+	if (b < 0)
+		return fix32_minimum;
+
+	return fix32__pow(b, exp);
+}
+
+/* The integer powers work on unsigned floats, x = m * 2^(e - 63) with the
+ * top bit of m set, so that every step keeps 64 significant bits and the
+ * rounding to Q32 happens only once at the end.
+ */
+
+/* Returns a * b as a normalized mantissa, rounded, and adds the exponent
+ * change to *e.
+ */
+static uint64_t fix32__mul_norm(uint64_t a, uint64_t b, int64_t *e)
+{
+	uint64_t hi, lo = fix32__umul128(a, b, &hi);
+	uint64_t m, round;
+
+	// The product is in [2^126, 2^128).
+	if (hi >> 63)
+	{
+		*e += 1;
+		m = hi;
+		round = lo >> 63;
+	}
+	else
+	{
+		m = (hi << 1) | (lo >> 63);
+		round = (lo >> 62) & 1;
+	}
+
+	m += round;
+	if (m == 0)
+	{
+		// Rounded up to the next power of two.
+		m = (uint64_t)1 << 63;
+		*e += 1;
+	}
+	return m;
+}
+
+/* Returns 2^127 / m rounded down, for m > 2^63. */
+static uint64_t fix32__recip64(uint64_t m)
+{
+	const uint64_t half = (uint64_t)1 << 63;
+	uint64_t q = fix32__recip_norm(m);
+	if (q >= half)
+		q = half - 1;
+	q <<= 1;
+
+	// The reciprocal is good to about 60 bits. The top of the remainder
+	// 2^127 - m * q, below 2^68, gives the correction to within one.
+	uint64_t hi, lo = fix32__umul128(m, q, &hi);
+	int64_t rem = (int64_t)(((half - hi - (lo != 0)) << 1) | ((0 - lo) >> 63));
+	q += (uint64_t)((rem * (int64_t)(q >> 32)) >> 32);
+
+	lo = fix32__umul128(m, q, &hi);
+	while (hi > half || (hi == half && lo != 0))
+	{
+		hi -= (lo < m);
+		lo -= m;
+		q--;
+	}
+	for (;;)
+	{
+		uint64_t next_lo = lo + m;
+		uint64_t next_hi = hi + (next_lo < lo);
+		if (next_hi > half || (next_hi == half && next_lo != 0))
+			break;
+		lo = next_lo;
+		hi = next_hi;
+		q++;
+	}
+	return q;
+}
+
+static fix32_t fix32__powi(fix32_t base, int n, bool saturate)
+{
+	bool negative = (base < 0) && (n & 1);
+	fix32_t huge = !saturate ? fix32_overflow : (negative ? fix32_minimum : fix32_maximum);
+
+	if (n == 0)
+		return fix32_one;
+
+	uint64_t b = (base < 0 ? -(uint64_t)base : (uint64_t)base);
+	if (b == 0)
+		return (n < 0 ? huge : 0);
+
+	// Square and multiply, the exponent of a square only doubles so it
+	// can not overflow for any int.
+	unsigned u = (n < 0 ? 0u - (unsigned)n : (unsigned)n);
+	int shift = clz(b);
+	uint64_t bm = b << shift;
+	int64_t be = 31 - shift;
+	uint64_t m = 0;
+	int64_t e = 0;
+
+	for (;;)
+	{
+		if (u & 1)
+		{
+			if (m == 0)
+			{
+				m = bm;
+				e = be;
+			}
+			else
+			{
+				e += be;
+				m = fix32__mul_norm(m, bm, &e);
+			}
+		}
+
+		u >>= 1;
+		if (u == 0)
+			break;
+
+		be += be;
+		bm = fix32__mul_norm(bm, bm, &be);
+	}
+
+	// The single reciprocal for negative exponents, exact for powers of two.
+	if (n < 0)
+	{
+		if (m == (uint64_t)1 << 63)
+		{
+			e = -e;
+		}
+		else
+		{
+			m = fix32__recip64(m);
+			e = -e - 1;
+		}
+	}
+
+	// To Q32, rounded.
+	if (e >= 31)
+		return huge;
+	if (e < -33)
+		return 0;
+
+	shift = (int)(31 - e);
+	uint64_t result = ((m >> (shift - 1)) + 1) >> 1;
+	if (result >> 63)
+		return huge;
+
+	return (negative ? -(fix32_t)result : (fix32_t)result);
+}
+
+fix32_t fix32_powi(fix32_t base, int n)
+{
+	return fix32__powi(base, n, false);
+}
+
+fix32_t fix32_spowi(fix32_t base, int n)
+{
+	return fix32__powi(base, n, true);
+}
+
+/* n-th roots as 2^(log2(|x|) / n), with log2 from the mantissa kernel in
+ * Q57 like fix32_pow. Unlike fix32_pow(x, 1/n) the exponent is exact to
+ * 2^-57, as the division is by the integer n, and the result is within
+ * 0.5 LSB plus 2^-50 relative.
+ */
+fix32_t fix32_rootn(fix32_t x, int n)
+{
+	bool negative = (x < 0);
+
+	if (n <= 0 || (negative && !(n & 1)))
+		return fix32_overflow;
+	if (n == 1)
+		return x;
+	if (n == 2)
+		return fix32_sqrt(x);
+	if (n == 3)
+		return fix32_cbrt(x);
+
+	uint64_t a = (negative ? -(uint64_t)x : (uint64_t)x);
+	if (a == 0)
+		return 0;
+
+	int shift = clz(a);
+	int64_t log2_a = (int64_t)((uint64_t)(31 - shift) << 57)
+		+ (fix32__mul_shr(fix32__ln_mantissa(a << shift), FIX32_LOG2_E_Q61, 61) >> 5);
+
+	// The root is in [2^-8, 2^8) for n >= 4.
+	fix32_t result = fix32__pow2_q57(log2_a / n);
+	return (negative ? -result : result);
+}
+
+
+/* The normal distribution function Phi(x) for GELU, on [0, 7) in 14
+ * segments of 1/2. Coefficients are in Q62, lowest order first, for the
+ * offset from the centre of the segment. The error is below 2^-44.
+ */
+static const int64_t _fix32_phi_poly[14][10] = {
+	{ 0x265134562DD7DA9E, 0x18BF2BA104BDF77E, -0x0317E574173E7BBA, -0x03DDDED126244693, 0x00C1D97BBFFCB403,
+	  0x008AC9BE0D55E322, -0x001FA051FBABE251, -0x000F64520BB794DD, 0x0003CFAB3BEEBB43, 0x00015F6A6212ED46 },
+	{ 0x317EEFFD4A6005BC, 0x1345D5EFAD34E26E, -0x073A3039D81EB3D2, -0x0167C244272490F3, 0x0177D1C756D9532C,
+	  -0x000268B97C1163CE, -0x0031CE1BA088DD26, 0x00059F5DA2118CAD, 0x0004C107D99AB29B, -0x0000EE855C8E0860 },
+	{ 0x393D08BB515AD80E, 0x0BB085CA18F8EC01, -0x074E539E557EDB71, 0x01188C8AF0ADB6CB, 0x00E00CB1E93287FF,
+	  -0x0062183FC06F1535, -0x0009705AE20744CC, 0x000D5CCEDA81B6FD, -0x00010A355C4025C9, -0x000123A3747767EF },
+	{ 0x3D6FABB7D756D913, 0x0585914DAFC517AA, -0x04D4DF23FF217770, 0x01E5E9F2B5D42FDF, -0x00067126DAD373E7,
+	  -0x0046A1E360A79673, 0x0015754E04AA3738, 0x00030B4930AF10A7, -0x0002EE83AD4007BB, 0x000045949FFB4EF1 },
+	{ 0x3F37B6D86F15B496, 0x020805BFA7B7F844, -0x024906779ACB4298, 0x01601939C4F5630A, -0x00648D1D812696A6,
+	  -0x00079115C7957E64, 0x00103EB873823A1F, -0x000452024F7BC33A, -0x0000898675564E48, 0x00008BFB9F8484DB },
+	{ 0x3FCF2DF796C1C6BD, 0x0094FD2A631A323A, -0x00CCDC1A4632F0ED, 0x00A2F4E65BF6CB41, -0x004DE3B05BF83BED,
+	  0x0012654AE3BE1AF9, 0x0001F461529A8096, -0x0002F52CA5B0CAE7, 0x0000CB5CCB21EA05, 0x00000B265696C3F7 },
+	{ 0x3FF68BC81417EF49, 0x00213E71C3146386, -0x00360578DD1E157C, 0x0034FB854EAC25A0, -0x00220B72C758DBBA,
+	  0x000E2E83908A6E39, -0x0003247A779CEB59, -0x00003AB8AEF696A2, 0x00006E3A6903795A, -0x000021A747F4B349 },
+	{ 0x3FFE8D26A9B4F703, 0x0005C6E4BB2AA577, -0x000AD4ECDF630CC9, 0x000C93ACA232B6D9, -0x0009FC4A23FA7151,
+	  0x00059A44407ED444, -0x00022B9E08D0AD22, 0x00007EE3C73E39A5, 0x000000C4F8AE402E, -0x00000C718FC59025 },
+	{ 0x3FFFD32B48682374, 0x0000C8257EEF4277, -0x0001A94FADD56CAC, 0x0002392AA104B6E6, -0x000215DAA199BFB4,
+	  0x00017066A8E1441E, -0x0000BDC75B5A24AF, 0x0000475D5395CC88, -0x0000116C263CB5EF, 0x0000014937B5DCCB },
+	{ 0x3FFFFBBBEA497CC2, 0x00001518646FBAB6, -0x00003219EE823079, 0x00004BCFA8F295DF, -0x000051ACF473F2E2,
+	  0x0000423857C0F71C, -0x000029881E4A5906, 0x0000144D08B8825F, -0x000007A6046125E7, 0x00000208610D9FBF },
+	{ 0x3FFFFFAE57A4C888, 0x000001BB4A8BE2B3, -0x0000048BA3AA62B1, 0x000007AA7CAFAEF6, -0x0000094DD5726057,
+	  0x0000089E8B5AE2C2, -0x0000064CBA2D634B, 0x000003B318956D6A, -0x000001C87119DF7F, 0x000000AB2CAF3089 },
+	{ 0x3FFFFFFB357286D2, 0x0000001C56B24C71, -0x00000051793F6D19, 0x000000976F486ACE, -0x000000CC1C5A48F6,
+	  0x000000D4029DAB4A, -0x000000AFDBAEEB2F, 0x0000007744C5BA68, -0x00000044C6CB9D86, 0x0000001FB84C0974 },
+	{ 0x3FFFFFFFC7967AD3, 0x000000016930A86A, -0x0000000468B7E22D, 0x00000008F34C9B25, -0x0000000D401F22B6,
+	  0x0000000F38620E1F, -0x0000000E1294D627, 0x0000000AC2AD8AEF, -0x000000072CDF5B76, 0x00000003DA453B08 },
+	{ 0x3FFFFFFFFDF7D0EB, 0x000000000E013E6E, -0x000000002F442E6C, 0x000000006803E5B5, -0x00000000A7A80606,
+	  0x00000000D2B9F060, -0x00000000D6565CC8, 0x00000000B5C91908, -0x00000000894A5E77, 0x00000000534B9E0E }
+	};
+
+/* Returns 1 / (1 + t) in unsigned Q63, for t in [0, 1) in Q63. */
+static uint64_t fix32__recip_1p(uint64_t t)
+{
+	// 2^63 + t is (1 + t) / 2 in Q64.
+	return fix32__recip_norm(((uint64_t)1 << 63) + t);
+}
+
+/* tanh(|x|) = 2 / (1 + t) - 1 with t = exp(-2|x|), so there is no
+ * cancellation near zero: the result only needs absolute precision.
+ */
+fix32_t fix32_tanh(fix32_t x)
+{
+	// 1 - tanh(x) is below 2^-33 from 12 on.
+	if (x >= fix32_from_int(12))
+		return fix32_one;
+	if (x <= -fix32_from_int(12))
+		return -fix32_one;
+	if (x == 0)
+		return 0;
+
+	fix32_t a = (x < 0 ? -x : x);
+	uint64_t s = fix32__recip_1p(fix32__exp_neg_q63(-2 * a));
+
+	// 2s - 1 in Q62, to Q32.
+	fix32_t result = (fix32_t)((s - ((uint64_t)1 << 62) + ((uint64_t)1 << 29)) >> 30);
+	return (x < 0 ? -result : result);
+}
+
+/* sigmoid(|x|) = 1 / (1 + exp(-|x|)) and sigmoid(-x) = 1 - sigmoid(x). */
+fix32_t fix32_sigmoid(fix32_t x)
+{
+	if (x >= fix32_from_int(24))
+		return fix32_one;
+	if (x <= -fix32_from_int(24))
+		return 0;
+	if (x == 0)
+		return fix32_one >> 1;
+
+	fix32_t a = (x < 0 ? -x : x);
+	uint64_t s = fix32__recip_1p(fix32__exp_neg_q63(-a));
+	if (x < 0)
+		s = ((uint64_t)1 << 63) - s;
+	return (fix32_t)((s + ((uint64_t)1 << 30)) >> 31);
+}
+
+/* softplus(x) = ln(1 + exp(x)) = max(x, 0) + ln(1 + exp(-|x|)), where the
+ * logarithm comes straight from the mantissa kernel.
+ */
+fix32_t fix32_softplus(fix32_t x)
+{
+	if (x >= fix32_from_int(24))
+		return x;
+	if (x <= -fix32_from_int(24))
+		return 0;
+	if (x == 0)
+		return (fix32_t)((FIX32_LN2_Q58 + ((int64_t)1 << 25)) >> 26);
+
+	fix32_t a = (x < 0 ? -x : x);
+	int64_t l = fix32__ln_mantissa(((uint64_t)1 << 63) + fix32__exp_neg_q63(-a));
+	return (x > 0 ? x : 0) + ((l + ((int64_t)1 << 29)) >> 30);
+}
+
+/* gelu(x) = x * Phi(x), the exact form rather than the tanh approximation.
+ * Phi(-x) = 1 - Phi(x), and Phi is a polynomial per segment.
+ */
+fix32_t fix32_gelu(fix32_t x)
+{
+	// x * (1 - Phi(x)) is below 2^-36 from 7 on.
+	if (x >= fix32_from_int(7))
+		return x;
+	if (x <= -fix32_from_int(7))
+		return 0;
+
+	uint64_t a = (uint64_t)(x < 0 ? -x : x);
+	int i = (int)(a >> 31);
+	int64_t s = (int64_t)((a - ((uint64_t)(2 * i + 1) << 30)) << 30);
+
+	const int64_t *c = _fix32_phi_poly[i];
+	int64_t p = c[9];
+	int k;
+	for (k = 8; k >= 0; k--)
+		p = c[k] + fix32__mul_shr(p, s, 62);
+
+	if (x < 0)
+		p = ((int64_t)1 << 62) - p;
+	return (fix32_t)((fix32__mul_shr(x, p, 61) + 1) >> 1);
+}
+
+void fix32_tanh_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_tanh(inValues[i]);
+}
+
+void fix32_sigmoid_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_sigmoid(inValues[i]);
+}
+
+void fix32_softplus_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_softplus(inValues[i]);
+}
+
+void fix32_gelu_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_gelu(inValues[i]);
+}
+
+
+
+/* Scales for the decimal logarithms and decibels, c * ln(x), in Q59. */
+static const int64_t FIX32_LOG10_E_Q59       = 0x03796F62A4DCA1C6; /*!< 1/ln(10) */
+static const int64_t FIX32_DB_POWER_Q59      = 0x22BE59DA709E51BF; /*!< 10/ln(10) */
+static const int64_t FIX32_DB_AMPLITUDE_Q59  = 0x457CB3B4E13CA37F; /*!< 20/ln(10) */
+
+/* Scales for the decimal exponentials, exp(x * c), as c in Q61 plus the
+ * next 32 bits, and c * 64/ln(2) in Q55 for the reduction.
+ */
+static const int64_t FIX32_LN10_Q61          = 0x49AEC6EED554560B; /*!< ln(10) ... */
+static const int64_t FIX32_LN10_LO           = 0x752B6B16;         /*!< ... and the next 32 bits */
+static const int64_t FIX32_64_LOG2_10_Q55    = 0x6A4D3C25E68DC57F; /*!< 64*log2(10) */
+static const int64_t FIX32_LN10_DIV_20_Q61   = 0x03AF238BF111044D; /*!< ln(10)/20 ... */
+static const int64_t FIX32_LN10_DIV_20_LO    = 0x5F755EF4;         /*!< ... and the next 32 bits */
+static const int64_t FIX32_64_LOG2_10_DIV_20_Q55 = 0x0550A9684B8716AD; /*!< 64*log2(10)/20 */
+
+/* Returns c * ln(x) with c in Q59, from ln(x) in Q58 with one rounding.
+ * Returns fix32_minimum for x <= 0.
+ */
+static fix32_t fix32__ln_scaled(fix32_t x, int64_t c)
+{
+	if (x <= 0)
+		return fix32_minimum;
+
+	int shift = clz((uint64_t)x);
+	int64_t ln = (31 - shift) * FIX32_LN2_Q58 + (fix32__ln_mantissa((uint64_t)x << shift) >> 4);
+	return (fix32__mul_shr(ln, c, 84) + 1) >> 1;
+}
+
+/* Returns exp(x * c), where x * c is formed to 2^-64 in Q64 and goes to the
+ * same reduction as fix32_exp. Saturates to fix32_maximum.
+ */
+static fix32_t fix32__exp_scaled(fix32_t x, int64_t c_hi, int64_t c_lo, int64_t c_64_div_ln2)
+{
+	int64_t n = (fix32__mul_shr(x, c_64_div_ln2, 86) + 1) >> 1;
+	if (n >= 64 * 32)
+		return fix32_maximum;
+	if (n < -64 * 35)
+		return 0;
+
+	uint64_t xc = (uint64_t)fix32__mul_shr(x, c_hi, 29) + (uint64_t)fix32__mul_shr(x, c_lo, 61);
+	return fix32__exp_reduced(n, fix32__exp_rem(n, xc));
+}
+
+fix32_t fix32_log10(fix32_t x)
+{
+	return fix32__ln_scaled(x, FIX32_LOG10_E_Q59);
+}
+
+fix32_t fix32_exp10(fix32_t x)
+{
+	return fix32__exp_scaled(x, FIX32_LN10_Q61, FIX32_LN10_LO, FIX32_64_LOG2_10_Q55);
+}
+
+fix32_t fix32_to_db_power(fix32_t x)
+{
+	return fix32__ln_scaled(x, FIX32_DB_POWER_Q59);
+}
+
+fix32_t fix32_to_db_amplitude(fix32_t x)
+{
+	return fix32__ln_scaled(x, FIX32_DB_AMPLITUDE_Q59);
+}
+
+fix32_t fix32_from_db(fix32_t db)
+{
+	return fix32__exp_scaled(db, FIX32_LN10_DIV_20_Q61, FIX32_LN10_DIV_20_LO, FIX32_64_LOG2_10_DIV_20_Q55);
+}
+
+void fix32_log10_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32__ln_scaled(inValues[i], FIX32_LOG10_E_Q59);
+}
+
+void fix32_exp10_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32__exp_scaled(inValues[i], FIX32_LN10_Q61, FIX32_LN10_LO, FIX32_64_LOG2_10_Q55);
+}
+
+void fix32_to_db_power_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32__ln_scaled(inValues[i], FIX32_DB_POWER_Q59);
+}
+
+void fix32_to_db_amplitude_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32__ln_scaled(inValues[i], FIX32_DB_AMPLITUDE_Q59);
+}
+
+void fix32_from_db_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32__exp_scaled(inValues[i], FIX32_LN10_DIV_20_Q61, FIX32_LN10_DIV_20_LO, FIX32_64_LOG2_10_DIV_20_Q55);
+}
+
+
+/* Reduced precision tiers.
+ *
+ * The _fast versions are accurate to 16 fractional bits and the _mid
+ * versions to 24, see fix32.h. Both compute in Q30 with plain 64 bit
+ * multiplies, and only the polynomial degrees differ between them.
+ */
+
+/* Minimax polynomials for 2^f on [0, 1), Q30, lowest order first. */
+static const int64_t _fix32_exp2_fast_poly[5] = {
+	0x40000EA6, 0x2C59AB19, 0x0F76721F, 0x034FCA40, 0x00DFF96F
+	};
+static const int64_t _fix32_exp2_mid_poly[7] = {
+	0x40000003, 0x2C5C84F4, 0x0F5FEF8E, 0x038CFEA1, 0x009EAA6C, 0x00144D4D, 0x0003951E
+	};
+
+static const int64_t FIX32_LOG2_E_Q62 = 0x5C551D94AE0BF85E; /*!< 1/ln(2) in Q62 */
+
+/* Returns 2^x for x in Q32, x < 31, with a polynomial of the given degree
+ * for the fraction and the integer part as a shift.
+ */
+static fix32_t fix32__pow2_tier(fix32_t x, const int64_t *poly, int degree)
+{
+	int64_t n = x >> 32;
+	int64_t f = (x & 0xFFFFFFFF) >> 2;
+	int64_t p = poly[degree];
+	int i;
+	for (i = degree - 1; i >= 0; i--)
+		p = poly[i] + ((p * f) >> 30);
+
+	// p = [1, 2) in Q30 times 2^n in Q32 is (p << 32) >> (30 - n), which
+	// needs no branch on the sign of n. Only n = 30 can overflow, when the
+	// polynomial rounds up to 2.
+	int shift = 30 - (int)n;
+	if (shift == 0 && p >= ((int64_t)1 << 31))
+		return fix32_maximum;
+	if (shift > 63)
+		return 0;
+	return (fix32_t)((((uint64_t)p << 32) + (((uint64_t)1 << shift) >> 1)) >> shift);
+}
+
+fix32_t fix32_pow2_fast(fix32_t x)
+{
+	if (x >= fix32_from_int(31))
+		return fix32_maximum;
+	if (x < fix32_from_int(-34))
+		return 0;
+	return fix32__pow2_tier(x, _fix32_exp2_fast_poly, 4);
+}
+
+fix32_t fix32_pow2_mid(fix32_t x)
+{
+	if (x >= fix32_from_int(31))
+		return fix32_maximum;
+	if (x < fix32_from_int(-34))
+		return 0;
+	return fix32__pow2_tier(x, _fix32_exp2_mid_poly, 6);
+}
+
+/* exp(x) = 2^(x / ln(2)), with the same bounds as fix32_exp. */
+fix32_t fix32_exp_fast(fix32_t x)
+{
+	if (x >= 92288378626LL)
+		return fix32_maximum;
+	if (x <= -98242467570LL)
+		return 0;
+	return fix32__pow2_tier(fix32__mul_shr(x, FIX32_LOG2_E_Q62, 62), _fix32_exp2_fast_poly, 4);
+}
+
+fix32_t fix32_exp_mid(fix32_t x)
+{
+	if (x >= 92288378626LL)
+		return fix32_maximum;
+	if (x <= -98242467570LL)
+		return 0;
+	return fix32__pow2_tier(fix32__mul_shr(x, FIX32_LOG2_E_Q62, 62), _fix32_exp2_mid_poly, 6);
+}
+
+/* Reciprocals r = 1/c of the centres c = 1 + (i + 1/2)/16 of the mantissa
+ * intervals in Q30, and -ln(r) and -log2(r) of the rounded values in Q32.
+ */
+static const int64_t _fix32_ln_tier_recip[16] = {
+	0x3E0F83E1, 0x3A83A83B, 0x3759F22A, 0x34834835, 0x31F3831F, 0x2FA0BE83, 0x2D82D82E, 0x2B931057,
+	0x29CBC14E, 0x28282828, 0x26A439F6, 0x253C8254, 0x23EE08FC, 0x22B63CBF, 0x2192E29F, 0x20820821
+	};
+static const int64_t _fix32_ln_tier_table[16] = {
+	0x007E0A6C3, 0x016F0D289, 0x0252AA5EE, 0x032A4B538, 0x03F7230DC, 0x04BA38AEB, 0x05746F6FB, 0x06268CE1C,
+	0x06D13DDF1, 0x07751A814, 0x0812A952F, 0x08AA61E96, 0x093CAF091, 0x09C9F069A, 0x0A527C2F1, 0x0AD6A025E
+	};
+static const int64_t _fix32_log2_tier_table[16] = {
+	0x00B5D69BB, 0x02118B117, 0x0359EBC58, 0x049101EA9, 0x05B888738, 0x06D1FAFDD, 0x07DEA159F, 0x08DF988F6,
+	0x09D5D9FD8, 0x0AC241136, 0x0BA58FEB6, 0x0C80730AE, 0x0D53847A7, 0x0E1F4E516, 0x0EE44CD5F, 0x0FA2F0459
+	};
+
+/* Minimax polynomials for ln(1 + z) / z and log2(1 + z) / z on |z| <= 1/31,
+ * Q30, lowest order first.
+ */
+static const int64_t _fix32_ln_fast_poly[2]   = { 0x4002D7A6, -0x200221C1 };
+static const int64_t _fix32_log2_fast_poly[2] = { 0x5C59375B, -0x2E2DA226 };
+static const int64_t _fix32_ln_mid_poly[4]    = { 0x3FFFFFE3, -0x1FFFFFE8, 0x1558BECE, -0x1002D7EB };
+static const int64_t _fix32_log2_mid_poly[4]  = { 0x5C551D6B, -0x2E2A8EA7, 0x1ECBF604, -0x1719618F };
+
+static const int64_t FIX32_LN2_Q32 = 0xB17217F8; /*!< ln(2) in Q32 */
+
+/* Returns log(x) = e * log(2) + log(r) + log(1 + z) in Q32 for x > 0, where
+ * x = m * 2^e with m = [1, 2), r from the tables and z = m * r - 1, which
+ * is exact.
+ */
+static fix32_t fix32__log_tier(fix32_t x, int64_t log_2, const int64_t *table,
+                               const int64_t *poly, int degree)
+{
+	int shift = clz((uint64_t)x);
+	uint64_t m = (uint64_t)x << shift;
+	int i = (int)(m >> 59) & 15;
+	int64_t z = (int64_t)(m >> 33) * _fix32_ln_tier_recip[i] - ((int64_t)1 << 60);
+	z = (z + ((int64_t)1 << 29)) >> 30;
+
+	int64_t p = poly[degree - 1];
+	int j;
+	for (j = degree - 2; j >= 0; j--)
+		p = poly[j] + ((p * z) >> 30);
+
+	return (31 - shift) * log_2 + table[i] + ((p * z + ((int64_t)1 << 27)) >> 28);
+}
+
+fix32_t fix32_ln_fast(fix32_t x)
+{
+	if (x <= 0)
+		return fix32_minimum;
+	return fix32__log_tier(x, FIX32_LN2_Q32, _fix32_ln_tier_table, _fix32_ln_fast_poly, 2);
+}
+
+fix32_t fix32_ln_mid(fix32_t x)
+{
+	if (x <= 0)
+		return fix32_minimum;
+	return fix32__log_tier(x, FIX32_LN2_Q32, _fix32_ln_tier_table, _fix32_ln_mid_poly, 4);
+}
+
+fix32_t fix32_log2_fast(fix32_t x)
+{
+	if (x <= 0)
+		return fix32_overflow;
+	return fix32__log_tier(x, fix32_one, _fix32_log2_tier_table, _fix32_log2_fast_poly, 2);
+}
+
+fix32_t fix32_log2_mid(fix32_t x)
+{
+	if (x <= 0)
+		return fix32_overflow;
+	return fix32__log_tier(x, fix32_one, _fix32_log2_tier_table, _fix32_log2_mid_poly, 4);
+}
@@ -0,0 +1,98 @@
+#ifndef __libfixmath_fix32_internal_h__
+#define __libfixmath_fix32_internal_h__
+
+/* Helpers shared by the library sources. Not part of the public interface,
+ * do not include this from application code.
+ */
+
+#include <stdint.h>
+
+/* Scale from radians to binary angles, where 2^64 is one full turn. */
+static const int64_t FIX32_TURNS_PER_RAD_Q31 = 0x145F306DC9C882A5; /*!< 2^32/(2*pi) in Q31 */
+
+#ifdef __GNUC__
+// Count leading zeros, using processor-specific instruction if available.
+#define clz(x) (__builtin_clzl(x) - (8 * sizeof(long) - 64))
+#else
+static uint8_t clz(uint64_t x)
+{
+	uint8_t result = 0;
+	if (x == 0) return 64;
+	while (!(x & 0xF000000000000000)) { result += 4; x <<= 4; }
+	while (!(x & 0x8000000000000000)) { result += 1; x <<= 1; }
+	return result;
+}
+#endif
+
+/* Full 64 x 64 -> 128 bit unsigned product. Returns the low word and
+ * stores the high word to *hi.
+ */
+static inline uint64_t fix32__umul128(uint64_t a, uint64_t b, uint64_t *hi)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 p = (unsigned __int128)a * b;
+	*hi = (uint64_t)(p >> 64);
+	return (uint64_t)p;
+#else
+	uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+	uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+
+	uint64_t p0 = a_lo * b_lo;
+	uint64_t p1 = a_lo * b_hi;
+	uint64_t p2 = a_hi * b_lo;
+	uint64_t p3 = a_hi * b_hi;
+
+	uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+	*hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+	return (mid << 32) | (uint32_t)p0;
+#endif
+}
+
+/* Signed 64 x 64 bit product shifted right by 'shift' bits (0..127),
+ * rounded towards minus infinity. Only the low 64 bits of the shifted
+ * product are returned, so the caller is responsible for the range.
+ * This is the building block for the internal high precision formats,
+ * e.g. fix32__mul_shr(a, b, 62) multiplies two Q62 numbers.
+ */
+static inline int64_t fix32__mul_shr(int64_t a, int64_t b, unsigned shift)
+{
+#if defined(__SIZEOF_INT128__)
+	return (int64_t)(((__int128)a * b) >> shift);
+#else
+	uint64_t hi, lo = fix32__umul128(a, b, &hi);
+	// Convert the unsigned product into a signed one.
+	if (a < 0) hi -= (uint64_t)b;
+	if (b < 0) hi -= (uint64_t)a;
+
+	if (shift == 0)
+		return lo;
+	if (shift < 64)
+		return (int64_t)((hi << (64 - shift)) | (lo >> shift));
+	return ((int64_t)hi >> (shift - 64));
+#endif
+}
+
+/* Unsigned counterpart of fix32__mul_shr. */
+static inline uint64_t fix32__umul_shr(uint64_t a, uint64_t b, unsigned shift)
+{
+	uint64_t hi, lo = fix32__umul128(a, b, &hi);
+	if (shift == 0)
+		return lo;
+	if (shift < 64)
+		return (hi << (64 - shift)) | (lo >> shift);
+	return (hi >> (shift - 64));
+}
+
+/* Returns 2^126 / den for a normalized den (top bit set).
+ * The reciprocal is seeded with a 64/32 bit hardware division and
+ * refined with one Newton-Raphson step, giving about 60 bits.
+ */
+static inline uint64_t fix32__recip_norm(uint64_t den)
+{
+	// First to 32 bits and then to 62 bits.
+	uint64_t recip = (((uint64_t)1 << 63) / ((den >> 32) + 1)) << 31;
+	uint64_t err = ((uint64_t)1 << 62) - fix32__umul_shr(den, recip, 64);
+	return recip + fix32__umul_shr(recip, err, 62);
+}
+
+#endif
@@ -0,0 +1,933 @@
+#include "fix32.h"
+#include "fix32_internal.h"
+
+/* Batch versions of the scalar functions.
+ *
+ * When the library is compiled with AVX-512 (F and DQ) or AVX2 and FMA
+ * enabled, e.g. with -march=native, the kernels below process 8 or 4
+ * values per iteration. Otherwise every element goes through the scalar
+ * function. The tail of an array is handled with masked loads and stores,
+ * so every element goes through the same arithmetic.
+ */
+
+#if (defined(__AVX512F__) && defined(__AVX512DQ__)) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+/* Sine and cosine.
+ *
+ * The range reduction is the one of fix32_rad_to_turns64, done exactly in
+ * integer lanes: the angle becomes a binary angle, whose top bits give the
+ * nearest quadrant and the rest the offset from it, |offset| <= pi/4.
+ * sin and cos of the offset are Taylor series in double precision lanes
+ * (error below 1e-15), so the results are within 0.5 LSB of the exact
+ * values and within 1 LSB of fix32_sin and fix32_cos.
+ */
+
+#define FIX32__SIN_S3  (-1.0 / 6)
+#define FIX32__SIN_S5  ( 1.0 / 120)
+#define FIX32__SIN_S7  (-1.0 / 5040)
+#define FIX32__SIN_S9  ( 1.0 / 362880)
+#define FIX32__SIN_S11 (-1.0 / 39916800)
+#define FIX32__SIN_S13 ( 1.0 / 6227020800)
+#define FIX32__COS_C2  (-1.0 / 2)
+#define FIX32__COS_C4  ( 1.0 / 24)
+#define FIX32__COS_C6  (-1.0 / 720)
+#define FIX32__COS_C8  ( 1.0 / 40320)
+#define FIX32__COS_C10 (-1.0 / 3628800)
+#define FIX32__COS_C12 ( 1.0 / 479001600)
+#define FIX32__COS_C14 (-1.0 / 87178291200)
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+
+#define FIX32__SINCOS_LANES 8
+
+/* fix32_rad_to_turns64 for 8 lanes. The 64 x 61 bit product is split in
+ * 32 bit halves; only bits 31..94 of it are needed, which is exact with
+ * the low words shifted down and the high words wrapping around.
+ */
+static inline __m512i fix32__rad_to_turns_avx512(__m512i x)
+{
+	const __m512i k    = _mm512_set1_epi64(FIX32_TURNS_PER_RAD_Q31);
+	const __m512i k_hi = _mm512_set1_epi64(FIX32_TURNS_PER_RAD_Q31 >> 32);
+	const __m512i k_lo = _mm512_set1_epi64(FIX32_TURNS_PER_RAD_Q31 & 0xFFFFFFFF);
+
+	__m512i t = _mm512_add_epi64(_mm512_mullo_epi64(_mm512_srai_epi64(x, 32), k),
+	                             _mm512_mul_epu32(x, k_hi));
+	return _mm512_add_epi64(_mm512_slli_epi64(t, 1),
+	                        _mm512_srli_epi64(_mm512_mul_epu32(x, k_lo), 31));
+}
+
+/* Returns sin (or cos, with quadrant_offset 1) of the 8 angles. */
+static inline __m512i fix32__sincos_avx512(__m512i x, uint64_t quadrant_offset)
+{
+	__m512i turns = fix32__rad_to_turns_avx512(x);
+	__m512i quadrant = _mm512_srli_epi64(
+		_mm512_add_epi64(turns, _mm512_set1_epi64((int64_t)1 << 61)), 62);
+	quadrant = _mm512_add_epi64(quadrant, _mm512_set1_epi64(quadrant_offset));
+
+	// Offset from the nearest quadrant, 2^63 is pi/4.
+	__m512d r  = _mm512_mul_pd(_mm512_cvtepi64_pd(_mm512_slli_epi64(turns, 2)),
+	                           _mm512_set1_pd(1.5707963267948966 / 18446744073709551616.0));
+	__m512d r2 = _mm512_mul_pd(r, r);
+
+	__m512d s = _mm512_set1_pd(FIX32__SIN_S13);
+	s = _mm512_fmadd_pd(s, r2, _mm512_set1_pd(FIX32__SIN_S11));
+	s = _mm512_fmadd_pd(s, r2, _mm512_set1_pd(FIX32__SIN_S9));
+	s = _mm512_fmadd_pd(s, r2, _mm512_set1_pd(FIX32__SIN_S7));
+	s = _mm512_fmadd_pd(s, r2, _mm512_set1_pd(FIX32__SIN_S5));
+	s = _mm512_fmadd_pd(s, r2, _mm512_set1_pd(FIX32__SIN_S3));
+	s = _mm512_fmadd_pd(_mm512_mul_pd(s, r2), r, r);
+
+	__m512d c = _mm512_set1_pd(FIX32__COS_C14);
+	c = _mm512_fmadd_pd(c, r2, _mm512_set1_pd(FIX32__COS_C12));
+	c = _mm512_fmadd_pd(c, r2, _mm512_set1_pd(FIX32__COS_C10));
+	c = _mm512_fmadd_pd(c, r2, _mm512_set1_pd(FIX32__COS_C8));
+	c = _mm512_fmadd_pd(c, r2, _mm512_set1_pd(FIX32__COS_C6));
+	c = _mm512_fmadd_pd(c, r2, _mm512_set1_pd(FIX32__COS_C4));
+	c = _mm512_fmadd_pd(c, r2, _mm512_set1_pd(FIX32__COS_C2));
+	c = _mm512_fmadd_pd(c, r2, _mm512_set1_pd(1.0));
+
+	// Odd quadrants take the cosine, quadrants 2 and 3 are negated.
+	__mmask8 odd = _mm512_test_epi64_mask(quadrant, _mm512_set1_epi64(1));
+	__m512d result = _mm512_mask_blend_pd(odd, s, c);
+	__m512i sign = _mm512_slli_epi64(_mm512_srli_epi64(quadrant, 1), 63);
+	result = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(result), sign));
+
+	return _mm512_cvtpd_epi64(_mm512_mul_pd(result, _mm512_set1_pd(4294967296.0)));
+}
+
+static void fix32__sincos_array(const fix32_t *inAngles, fix32_t *outValues, size_t n,
+	uint64_t quadrant_offset)
+{
+	size_t i;
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		__m512i x = _mm512_loadu_si512((const void *)(inAngles + i));
+		_mm512_storeu_si512((void *)(outValues + i), fix32__sincos_avx512(x, quadrant_offset));
+	}
+	if (i < n)
+	{
+		__mmask8 mask = (__mmask8)((1u << (n - i)) - 1);
+		__m512i x = _mm512_maskz_loadu_epi64(mask, inAngles + i);
+		_mm512_mask_storeu_epi64(outValues + i, mask, fix32__sincos_avx512(x, quadrant_offset));
+	}
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+#define FIX32__SINCOS_LANES 4
+
+/* fix32_rad_to_turns64 for 4 lanes, see the AVX-512 version. AVX2 has no
+ * 64 bit multiply, so the high word product is done in 32 bit halves, and
+ * the high word is treated as unsigned and corrected for negative inputs.
+ */
+static inline __m256i fix32__rad_to_turns_avx2(__m256i x)
+{
+	const __m256i k_hi = _mm256_set1_epi64x(FIX32_TURNS_PER_RAD_Q31 >> 32);
+	const __m256i k_lo = _mm256_set1_epi64x(FIX32_TURNS_PER_RAD_Q31 & 0xFFFFFFFF);
+	const __m256i k_neg = _mm256_set1_epi64x((uint64_t)FIX32_TURNS_PER_RAD_Q31 << 33);
+
+	__m256i x_hi = _mm256_srli_epi64(x, 32);
+	__m256i t = _mm256_add_epi64(_mm256_mul_epu32(x_hi, k_lo),
+	                             _mm256_slli_epi64(_mm256_mul_epu32(x_hi, k_hi), 32));
+	t = _mm256_add_epi64(t, _mm256_mul_epu32(x, k_hi));
+	t = _mm256_add_epi64(_mm256_slli_epi64(t, 1),
+	                     _mm256_srli_epi64(_mm256_mul_epu32(x, k_lo), 31));
+
+	__m256i negative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+	return _mm256_sub_epi64(t, _mm256_and_si256(negative, k_neg));
+}
+
+/* Returns sin (or cos, with quadrant_offset 1) of the 4 angles. */
+static inline __m256i fix32__sincos_avx2(__m256i x, uint64_t quadrant_offset)
+{
+	// 2^52 + 2^51 as a double, integers below 2^51 in magnitude added to it
+	// appear in the low bits of the mantissa.
+	const __m256i magic = _mm256_set1_epi64x(0x4338000000000000);
+
+	__m256i turns = fix32__rad_to_turns_avx2(x);
+	__m256i quadrant = _mm256_srli_epi64(
+		_mm256_add_epi64(turns, _mm256_set1_epi64x((int64_t)1 << 61)), 62);
+	quadrant = _mm256_add_epi64(quadrant, _mm256_set1_epi64x(quadrant_offset));
+
+	// Offset from the nearest quadrant, 2^51 is pi/4. There is no 64 bit
+	// conversion either, so the sign is flipped to get an unsigned 52 bit
+	// value, which is then biased back with the magic number.
+	__m256i offset = _mm256_srli_epi64(_mm256_xor_si256(_mm256_slli_epi64(turns, 2),
+	                                   _mm256_set1_epi64x(INT64_MIN)), 12);
+	__m256d r = _mm256_sub_pd(
+		_mm256_castsi256_pd(_mm256_or_si256(offset, _mm256_set1_epi64x(0x4330000000000000))),
+		_mm256_castsi256_pd(magic));
+	r = _mm256_mul_pd(r, _mm256_set1_pd(1.5707963267948966 / 4503599627370496.0));
+	__m256d r2 = _mm256_mul_pd(r, r);
+
+	__m256d s = _mm256_set1_pd(FIX32__SIN_S13);
+	s = _mm256_fmadd_pd(s, r2, _mm256_set1_pd(FIX32__SIN_S11));
+	s = _mm256_fmadd_pd(s, r2, _mm256_set1_pd(FIX32__SIN_S9));
+	s = _mm256_fmadd_pd(s, r2, _mm256_set1_pd(FIX32__SIN_S7));
+	s = _mm256_fmadd_pd(s, r2, _mm256_set1_pd(FIX32__SIN_S5));
+	s = _mm256_fmadd_pd(s, r2, _mm256_set1_pd(FIX32__SIN_S3));
+	s = _mm256_fmadd_pd(_mm256_mul_pd(s, r2), r, r);
+
+	__m256d c = _mm256_set1_pd(FIX32__COS_C14);
+	c = _mm256_fmadd_pd(c, r2, _mm256_set1_pd(FIX32__COS_C12));
+	c = _mm256_fmadd_pd(c, r2, _mm256_set1_pd(FIX32__COS_C10));
+	c = _mm256_fmadd_pd(c, r2, _mm256_set1_pd(FIX32__COS_C8));
+	c = _mm256_fmadd_pd(c, r2, _mm256_set1_pd(FIX32__COS_C6));
+	c = _mm256_fmadd_pd(c, r2, _mm256_set1_pd(FIX32__COS_C4));
+	c = _mm256_fmadd_pd(c, r2, _mm256_set1_pd(FIX32__COS_C2));
+	c = _mm256_fmadd_pd(c, r2, _mm256_set1_pd(1.0));
+
+	// Odd quadrants take the cosine, quadrants 2 and 3 are negated.
+	__m256d odd = _mm256_castsi256_pd(_mm256_slli_epi64(quadrant, 63));
+	__m256d result = _mm256_blendv_pd(s, c, odd);
+	__m256i sign = _mm256_slli_epi64(_mm256_srli_epi64(quadrant, 1), 63);
+	result = _mm256_castsi256_pd(_mm256_xor_si256(_mm256_castpd_si256(result), sign));
+
+	// Round to Q32 with the magic number, the result is at most 2^32.
+	result = _mm256_fmadd_pd(result, _mm256_set1_pd(4294967296.0), _mm256_castsi256_pd(magic));
+	return _mm256_sub_epi64(_mm256_castpd_si256(result), magic);
+}
+
+static void fix32__sincos_array(const fix32_t *inAngles, fix32_t *outValues, size_t n,
+	uint64_t quadrant_offset)
+{
+	size_t i;
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i *)(inAngles + i));
+		_mm256_storeu_si256((__m256i *)(outValues + i), fix32__sincos_avx2(x, quadrant_offset));
+	}
+	if (i < n)
+	{
+		const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+		__m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n - i), lanes);
+		__m256i x = _mm256_maskload_epi64((const long long *)(inAngles + i), mask);
+		_mm256_maskstore_epi64((long long *)(outValues + i), mask,
+			fix32__sincos_avx2(x, quadrant_offset));
+	}
+}
+
+#endif
+
+void fix32_sin_array(const fix32_t *inAngles, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__SINCOS_LANES
+	fix32__sincos_array(inAngles, outValues, n, 0);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_sin(inAngles[i]);
+	#endif
+}
+
+void fix32_cos_array(const fix32_t *inAngles, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__SINCOS_LANES
+	fix32__sincos_array(inAngles, outValues, n, 1);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_cos(inAngles[i]);
+	#endif
+}
+
+
+/* Exponentials and logarithms.
+ *
+ * These use the same formulations as the scalar kernels, in double
+ * precision lanes: exp(x) = 2^k * 2^(j/64) * exp(r) with the table entry
+ * gathered and a short Taylor series for exp(r), and ln(x) = e * ln(2) +
+ * ln(c) + ln(1 + z), where c is the centre of one of 64 mantissa intervals
+ * and z = m/c - 1. The reductions are exact, so the logarithms are within
+ * 0.5 LSB of the exact values and within 1 LSB of fix32_ln and fix32_log2.
+ * The exponentials carry the 53 bit precision of a double, so they are
+ * within 1 LSB of fix32_exp and fix32_pow2 for results up to 2^18 and
+ * within 2^-50 relative above.
+ */
+
+#if (defined(__AVX512F__) && defined(__AVX512DQ__)) || (defined(__AVX2__) && defined(__FMA__))
+
+/* 2^(j/64) for j = 0..63. */
+static const double _fix32_exp2_table_d[64] = {
+	0x1.0000000000000p+0, 0x1.02c9a3e778061p+0, 0x1.059b0d3158574p+0, 0x1.0874518759bc8p+0,
+	0x1.0b5586cf9890fp+0, 0x1.0e3ec32d3d1a2p+0, 0x1.11301d0125b51p+0, 0x1.1429aaea92de0p+0,
+	0x1.172b83c7d517bp+0, 0x1.1a35beb6fcb75p+0, 0x1.1d4873168b9aap+0, 0x1.2063b88628cd6p+0,
+	0x1.2387a6e756238p+0, 0x1.26b4565e27cddp+0, 0x1.29e9df51fdee1p+0, 0x1.2d285a6e4030bp+0,
+	0x1.306fe0a31b715p+0, 0x1.33c08b26416ffp+0, 0x1.371a7373aa9cbp+0, 0x1.3a7db34e59ff7p+0,
+	0x1.3dea64c123422p+0, 0x1.4160a21f72e2ap+0, 0x1.44e086061892dp+0, 0x1.486a2b5c13cd0p+0,
+	0x1.4bfdad5362a27p+0, 0x1.4f9b2769d2ca7p+0, 0x1.5342b569d4f82p+0, 0x1.56f4736b527dap+0,
+	0x1.5ab07dd485429p+0, 0x1.5e76f15ad2148p+0, 0x1.6247eb03a5585p+0, 0x1.6623882552225p+0,
+	0x1.6a09e667f3bcdp+0, 0x1.6dfb23c651a2fp+0, 0x1.71f75e8ec5f74p+0, 0x1.75feb564267c9p+0,
+	0x1.7a11473eb0187p+0, 0x1.7e2f336cf4e62p+0, 0x1.82589994cce13p+0, 0x1.868d99b4492edp+0,
+	0x1.8ace5422aa0dbp+0, 0x1.8f1ae99157736p+0, 0x1.93737b0cdc5e5p+0, 0x1.97d829fde4e50p+0,
+	0x1.9c49182a3f090p+0, 0x1.a0c667b5de565p+0, 0x1.a5503b23e255dp+0, 0x1.a9e6b5579fdbfp+0,
+	0x1.ae89f995ad3adp+0, 0x1.b33a2b84f15fbp+0, 0x1.b7f76f2fb5e47p+0, 0x1.bcc1e904bc1d2p+0,
+	0x1.c199bdd85529cp+0, 0x1.c67f12e57d14bp+0, 0x1.cb720dcef9069p+0, 0x1.d072d4a07897cp+0,
+	0x1.d5818dcfba487p+0, 0x1.da9e603db3285p+0, 0x1.dfc97337b9b5fp+0, 0x1.e502ee78b3ff6p+0,
+	0x1.ea4afa2a490dap+0, 0x1.efa1bee615a27p+0, 0x1.f50765b6e4540p+0, 0x1.fa7c1819e90d8p+0
+	};
+
+/* 1/c for the centres c = 1 + (i + 1/2)/64 of the mantissa intervals,
+ * rounded to double, and -ln of those rounded values.
+ */
+static const double _fix32_ln_recip_d[64] = {
+	0x1.fc07f01fc07f0p-1, 0x1.f44659e4a4271p-1, 0x1.ecc07b301ecc0p-1, 0x1.e573ac901e574p-1,
+	0x1.de5d6e3f8868ap-1, 0x1.d77b654b82c34p-1, 0x1.d0cb58f6ec074p-1, 0x1.ca4b3055ee191p-1,
+	0x1.c3f8f01c3f8f0p-1, 0x1.bdd2b899406f7p-1, 0x1.b7d6c3dda338bp-1, 0x1.b2036406c80d9p-1,
+	0x1.ac5701ac5701bp-1, 0x1.a6d01a6d01a6dp-1, 0x1.a16d3f97a4b02p-1, 0x1.9c2d14ee4a102p-1,
+	0x1.970e4f80cb872p-1, 0x1.920fb49d0e229p-1, 0x1.8d3018d3018d3p-1, 0x1.886e5f0abb04ap-1,
+	0x1.83c977ab2beddp-1, 0x1.7f405fd017f40p-1, 0x1.7ad2208e0ecc3p-1, 0x1.767dce434a9b1p-1,
+	0x1.724287f46debcp-1, 0x1.6e1f76b4337c7p-1, 0x1.6a13cd1537290p-1, 0x1.661ec6a5122f9p-1,
+	0x1.623fa77016240p-1, 0x1.5e75bb8d015e7p-1, 0x1.5ac056b015ac0p-1, 0x1.571ed3c506b3ap-1,
+	0x1.5390948f40febp-1, 0x1.5015015015015p-1, 0x1.4cab88725af6ep-1, 0x1.49539e3b2d067p-1,
+	0x1.460cbc7f5cf9ap-1, 0x1.42d6625d51f87p-1, 0x1.3fb013fb013fbp-1, 0x1.3c995a47babe7p-1,
+	0x1.3991c2c187f63p-1, 0x1.3698df3de0748p-1, 0x1.33ae45b57bcb2p-1, 0x1.30d190130d190p-1,
+	0x1.2e025c04b8097p-1, 0x1.2b404ad012b40p-1, 0x1.288b01288b013p-1, 0x1.25e22708092f1p-1,
+	0x1.23456789abcdfp-1, 0x1.20b470c67c0d9p-1, 0x1.1e2ef3b3fb874p-1, 0x1.1bb4a4046ed29p-1,
+	0x1.19453808ca29cp-1, 0x1.16e0689427379p-1, 0x1.1485f0e0acd3bp-1, 0x1.12358e75d3033p-1,
+	0x1.0fef010fef011p-1, 0x1.0db20a88f4696p-1, 0x1.0b7e6ec259dc8p-1, 0x1.0953f39010954p-1,
+	0x1.073260a47f7c6p-1, 0x1.05197f7d73404p-1, 0x1.03091b51f5e1ap-1, 0x1.0101010101010p-1
+	};
+static const double _fix32_ln_table_d[64] = {
+	0x1.fe02a6b106799p-8, 0x1.7b91b07d5b126p-6, 0x1.39e87b9febd68p-5, 0x1.b42dd711971b9p-5,
+	0x1.16536eea37ae3p-4, 0x1.51b073f06183cp-4, 0x1.8c345d6319b23p-4, 0x1.c5e548f5bc743p-4,
+	0x1.fec9131dbeabcp-4, 0x1.1b72ad52f67a2p-3, 0x1.371fc201e8f75p-3, 0x1.526e5e3a1b438p-3,
+	0x1.6d60fe719d21bp-3, 0x1.87fa06520c911p-3, 0x1.a23bc1fe2b561p-3, 0x1.bc286742d8cd4p-3,
+	0x1.d5c216b4fbb94p-3, 0x1.ef0adcbdc5935p-3, 0x1.0402594b4d041p-2, 0x1.1058bf9ae4ad4p-2,
+	0x1.1c898c16999fbp-2, 0x1.2895a13de86a4p-2, 0x1.347dd9a987d56p-2, 0x1.404308686a7e4p-2,
+	0x1.4be5f957778a1p-2, 0x1.5767717455a6cp-2, 0x1.62c82f2b9c796p-2, 0x1.6e08eaa2ba1e4p-2,
+	0x1.792a55fdd47a1p-2, 0x1.842d1da1e8b18p-2, 0x1.8f11e873662c8p-2, 0x1.99d958117e08ap-2,
+	0x1.a484090e5bb09p-2, 0x1.af1293247786bp-2, 0x1.b9858969310fdp-2, 0x1.c3dd7a7cdad4dp-2,
+	0x1.ce1af0b85f3ecp-2, 0x1.d83e7258a2f3ep-2, 0x1.e24881a7c6c26p-2, 0x1.ec399d2468cc1p-2,
+	0x1.f6123fa7028adp-2, 0x1.ffd2e0857f497p-2, 0x1.04bdf9da926d2p-1, 0x1.0986f4f573521p-1,
+	0x1.0e44985d1cc8cp-1, 0x1.12f719593efbdp-1, 0x1.179eabbd899a0p-1, 0x1.1c3b81f713c25p-1,
+	0x1.20cdcd192ab6ep-1, 0x1.2555bce98f7cap-1, 0x1.29d37fec2b08bp-1, 0x1.2e47436e40268p-1,
+	0x1.32b1339121d71p-1, 0x1.37117b54747b6p-1, 0x1.3b68449fffc23p-1, 0x1.3fb5b84d16f43p-1,
+	0x1.43f9fe2f9ce67p-1, 0x1.48353d1ea88dfp-1, 0x1.4c679afccee39p-1, 0x1.50913cc01686bp-1,
+	0x1.54b2467999498p-1, 0x1.58cadb5cd7989p-1, 0x1.5cdb1dc6c1765p-1, 0x1.60e32f44788d9p-1
+
+	};
+
+#define FIX32__LN2_DIV_64_HI 0x1.62e42fefa4000p-7   /* ln(2)/64 to 40 bits, n * it is exact */
+#define FIX32__LN2_DIV_64_LO (-0x1.8432a1b0e2634p-49)
+#define FIX32__64_DIV_LN2    0x1.71547652b82fep+6
+#define FIX32__LN2           0x1.62e42fefa39efp-1
+#define FIX32__LOG2_E        0x1.71547652b82fep+0
+
+/* Bounds of fix32_exp and fix32_pow2, outside they saturate or return 0. */
+#define FIX32__EXP_MAX       92288378626LL
+#define FIX32__EXP_MIN       (-98242467570LL)
+#define FIX32__POW2_MAX      ((int64_t)31 << 32)
+#define FIX32__POW2_MIN      (-((int64_t)34 << 32))
+
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+
+#define FIX32__EXPLOG_LANES 8
+
+/* Returns 2^(n/64) * exp(r) in Q32, for integer n in double lanes. Lanes
+ * in big saturate to fix32_maximum, lanes in zero return 0.
+ */
+static inline __m512i fix32__exp_reduced_avx512(__m512d n, __m512d r, __mmask8 big, __mmask8 zero)
+{
+	__m512i ni = _mm512_cvtpd_epi64(n);
+	__m512i j = _mm512_and_si512(ni, _mm512_set1_epi64(63));
+	__m512i k = _mm512_srai_epi64(ni, 6);
+	__m512d table = _mm512_i64gather_pd(j, _fix32_exp2_table_d, 8);
+
+	// exp(r) - 1, |r| <= ln(2)/128.
+	__m512d p = _mm512_set1_pd(1.0 / 720);
+	p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 120));
+	p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 24));
+	p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 6));
+	p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 2));
+	p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+	p = _mm512_mul_pd(p, r);
+	__m512d y = _mm512_fmadd_pd(table, p, table);
+
+	// Times 2^(k + 32) in the exponent field, and to Q32 below 2^63.
+	__m512i scale = _mm512_slli_epi64(_mm512_add_epi64(k, _mm512_set1_epi64(32)), 52);
+	y = _mm512_castsi512_pd(_mm512_add_epi64(_mm512_castpd_si512(y), scale));
+	y = _mm512_min_pd(y, _mm512_set1_pd(9223372036854774784.0));
+
+	__m512i result = _mm512_cvtpd_epi64(y);
+	result = _mm512_mask_mov_epi64(result, big, _mm512_set1_epi64(INT64_MAX));
+	return _mm512_mask_mov_epi64(result, zero, _mm512_setzero_si512());
+}
+
+static inline __m512i fix32__exp_avx512(__m512i x)
+{
+	const __m512i max = _mm512_set1_epi64(FIX32__EXP_MAX);
+	const __m512i min = _mm512_set1_epi64(FIX32__EXP_MIN);
+	__mmask8 big = _mm512_cmpge_epi64_mask(x, max);
+	__mmask8 zero = _mm512_cmple_epi64_mask(x, min);
+	x = _mm512_min_epi64(_mm512_max_epi64(x, min), max);
+
+	// x is exact in a double, and n * ln(2)/64 is split so that the first
+	// product is exact as well.
+	__m512d xd = _mm512_mul_pd(_mm512_cvtepi64_pd(x), _mm512_set1_pd(1.0 / 4294967296.0));
+	__m512d n = _mm512_roundscale_pd(_mm512_mul_pd(xd, _mm512_set1_pd(FIX32__64_DIV_LN2)),
+	                                 _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	__m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(FIX32__LN2_DIV_64_HI), xd);
+	r = _mm512_fnmadd_pd(n, _mm512_set1_pd(FIX32__LN2_DIV_64_LO), r);
+
+	return fix32__exp_reduced_avx512(n, r, big, zero);
+}
+
+static inline __m512i fix32__pow2_avx512(__m512i x)
+{
+	const __m512i max = _mm512_set1_epi64(FIX32__POW2_MAX);
+	const __m512i min = _mm512_set1_epi64(FIX32__POW2_MIN);
+	__mmask8 big = _mm512_cmpge_epi64_mask(x, max);
+	__mmask8 zero = _mm512_cmplt_epi64_mask(x, min);
+	x = _mm512_min_epi64(_mm512_max_epi64(x, min), max);
+
+	// x = n/64 + f exactly, and r = f * ln(2).
+	__m512d xd = _mm512_mul_pd(_mm512_cvtepi64_pd(x), _mm512_set1_pd(1.0 / 4294967296.0));
+	__m512d n = _mm512_roundscale_pd(_mm512_mul_pd(xd, _mm512_set1_pd(64.0)),
+	                                 _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	__m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(1.0 / 64), xd);
+	r = _mm512_mul_pd(r, _mm512_set1_pd(FIX32__LN2));
+
+	return fix32__exp_reduced_avx512(n, r, big, zero);
+}
+
+/* Returns ln(x) in double lanes, in units of the real value, not Q32. */
+static inline __m512d fix32__ln_avx512(__m512i x)
+{
+	__m512i bits = _mm512_castpd_si512(_mm512_cvtepi64_pd(x));
+	__m512d e = _mm512_cvtepi64_pd(_mm512_sub_epi64(_mm512_srli_epi64(bits, 52),
+	                                                _mm512_set1_epi64(1023 + 32)));
+	__m512i i = _mm512_and_si512(_mm512_srli_epi64(bits, 46), _mm512_set1_epi64(63));
+	__m512d m = _mm512_castsi512_pd(_mm512_or_si512(
+		_mm512_and_si512(bits, _mm512_set1_epi64(0x000FFFFFFFFFFFFF)),
+		_mm512_set1_epi64(0x3FF0000000000000)));
+
+	// z = m/c - 1 is exact, |z| < 1/127.
+	__m512d z = _mm512_fmsub_pd(m, _mm512_i64gather_pd(i, _fix32_ln_recip_d, 8), _mm512_set1_pd(1.0));
+	__m512d p = _mm512_set1_pd(1.0 / 7);
+	p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(-1.0 / 6));
+	p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0 / 5));
+	p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(-1.0 / 4));
+	p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0 / 3));
+	p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(-1.0 / 2));
+	p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(1.0));
+	p = _mm512_fmadd_pd(p, z, _mm512_i64gather_pd(i, _fix32_ln_table_d, 8));
+
+	return _mm512_fmadd_pd(e, _mm512_set1_pd(FIX32__LN2), p);
+}
+
+/* Rounds to Q32, lanes with x <= 0 give fix32_minimum. */
+static inline __m512i fix32__log_result_avx512(__m512i x, __m512d result)
+{
+	__m512i q = _mm512_cvtpd_epi64(_mm512_mul_pd(result, _mm512_set1_pd(4294967296.0)));
+	__mmask8 invalid = _mm512_cmple_epi64_mask(x, _mm512_setzero_si512());
+	return _mm512_mask_mov_epi64(q, invalid, _mm512_set1_epi64(INT64_MIN));
+}
+
+static inline __m512i fix32__ln_q32_avx512(__m512i x)
+{
+	return fix32__log_result_avx512(x, fix32__ln_avx512(x));
+}
+
+static inline __m512i fix32__log2_q32_avx512(__m512i x)
+{
+	return fix32__log_result_avx512(x, _mm512_mul_pd(fix32__ln_avx512(x), _mm512_set1_pd(FIX32__LOG2_E)));
+}
+
+static inline void fix32__map_avx512(const fix32_t *inValues, fix32_t *outValues, size_t n,
+	__m512i (*kernel)(__m512i))
+{
+	size_t i;
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		__m512i x = _mm512_loadu_si512((const void *)(inValues + i));
+		_mm512_storeu_si512((void *)(outValues + i), kernel(x));
+	}
+	if (i < n)
+	{
+		__mmask8 mask = (__mmask8)((1u << (n - i)) - 1);
+		__m512i x = _mm512_maskz_loadu_epi64(mask, inValues + i);
+		_mm512_mask_storeu_epi64(outValues + i, mask, kernel(x));
+	}
+}
+
+#define FIX32__EXPLOG_MAP(kernel) fix32__map_avx512(inValues, outValues, n, fix32__##kernel##_avx512)
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+#define FIX32__EXPLOG_LANES 4
+
+/* Conversions that AVX2 lacks. Signed integers below 2^51 in magnitude
+ * convert both ways by adding 2^52 + 2^51, see fix32__sincos_avx2.
+ */
+static inline __m256d fix32__small_to_pd_avx2(__m256i x)
+{
+	const __m256i magic = _mm256_set1_epi64x(0x4338000000000000);
+	return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(x, magic)), _mm256_castsi256_pd(magic));
+}
+
+static inline __m256i fix32__small_from_pd_avx2(__m256d x)
+{
+	const __m256i magic = _mm256_set1_epi64x(0x4338000000000000);
+	return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(x, _mm256_castsi256_pd(magic))), magic);
+}
+
+/* Positive int64 to double, rounded once, through two exact 32 bit halves. */
+static inline __m256d fix32__positive_to_pd_avx2(__m256i x)
+{
+	const __m256i magic = _mm256_set1_epi64x(0x4330000000000000);
+	__m256d hi = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(x, 32), magic)),
+	                           _mm256_castsi256_pd(magic));
+	__m256d lo = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_blend_epi32(magic, x, 0x55)),
+	                           _mm256_castsi256_pd(magic));
+	return _mm256_fmadd_pd(hi, _mm256_set1_pd(4294967296.0), lo);
+}
+
+/* Double in [0, 2^63) to int64, rounded. Below 2^52 with the magic number,
+ * above the value is an integer and the mantissa is shifted into place.
+ */
+static inline __m256i fix32__positive_from_pd_avx2(__m256d x)
+{
+	const __m256i magic = _mm256_set1_epi64x(0x4330000000000000);
+	__m256i small = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(x, _mm256_castsi256_pd(magic))), magic);
+
+	__m256i bits = _mm256_castpd_si256(x);
+	__m256i mantissa = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFF)),
+	                                   _mm256_set1_epi64x(0x0010000000000000));
+	__m256i shift = _mm256_sub_epi64(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(1075));
+	__m256i big = _mm256_sllv_epi64(mantissa, shift);
+
+	__m256d is_big = _mm256_cmp_pd(x, _mm256_castsi256_pd(magic), _CMP_GE_OQ);
+	return _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(small), _mm256_castsi256_pd(big), is_big));
+}
+
+/* Clamps x to [min, max]. */
+static inline __m256i fix32__clamp_avx2(__m256i x, __m256i min, __m256i max)
+{
+	x = _mm256_blendv_epi8(x, max, _mm256_cmpgt_epi64(x, max));
+	return _mm256_blendv_epi8(x, min, _mm256_cmpgt_epi64(min, x));
+}
+
+/* See fix32__exp_reduced_avx512, big and zero are lane masks. */
+static inline __m256i fix32__exp_reduced_avx2(__m256d n, __m256d r, __m256i big, __m256i zero)
+{
+	__m256i ni = fix32__small_from_pd_avx2(n);
+	__m256i j = _mm256_and_si256(ni, _mm256_set1_epi64x(63));
+	__m256i k = _mm256_sub_epi64(_mm256_srli_epi64(_mm256_add_epi64(ni, _mm256_set1_epi64x(64 * 64)), 6),
+	                             _mm256_set1_epi64x(64));
+	__m256d table = _mm256_i64gather_pd(_fix32_exp2_table_d, j, 8);
+
+	__m256d p = _mm256_set1_pd(1.0 / 720);
+	p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 120));
+	p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 24));
+	p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 6));
+	p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 2));
+	p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+	p = _mm256_mul_pd(p, r);
+	__m256d y = _mm256_fmadd_pd(table, p, table);
+
+	__m256i scale = _mm256_slli_epi64(_mm256_add_epi64(k, _mm256_set1_epi64x(32)), 52);
+	y = _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(y), scale));
+	y = _mm256_min_pd(y, _mm256_set1_pd(9223372036854774784.0));
+
+	__m256i result = fix32__positive_from_pd_avx2(y);
+	result = _mm256_blendv_epi8(result, _mm256_set1_epi64x(INT64_MAX), big);
+	return _mm256_andnot_si256(zero, result);
+}
+
+static inline __m256i fix32__exp_avx2(__m256i x)
+{
+	const __m256i max = _mm256_set1_epi64x(FIX32__EXP_MAX);
+	const __m256i min = _mm256_set1_epi64x(FIX32__EXP_MIN);
+	__m256i big = _mm256_cmpgt_epi64(x, _mm256_set1_epi64x(FIX32__EXP_MAX - 1));
+	__m256i zero = _mm256_cmpgt_epi64(_mm256_set1_epi64x(FIX32__EXP_MIN + 1), x);
+	x = fix32__clamp_avx2(x, min, max);
+
+	__m256d xd = _mm256_mul_pd(fix32__small_to_pd_avx2(x), _mm256_set1_pd(1.0 / 4294967296.0));
+	__m256d n = _mm256_round_pd(_mm256_mul_pd(xd, _mm256_set1_pd(FIX32__64_DIV_LN2)),
+	                            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	__m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(FIX32__LN2_DIV_64_HI), xd);
+	r = _mm256_fnmadd_pd(n, _mm256_set1_pd(FIX32__LN2_DIV_64_LO), r);
+
+	return fix32__exp_reduced_avx2(n, r, big, zero);
+}
+
+static inline __m256i fix32__pow2_avx2(__m256i x)
+{
+	const __m256i max = _mm256_set1_epi64x(FIX32__POW2_MAX);
+	const __m256i min = _mm256_set1_epi64x(FIX32__POW2_MIN);
+	__m256i big = _mm256_cmpgt_epi64(x, _mm256_set1_epi64x(FIX32__POW2_MAX - 1));
+	__m256i zero = _mm256_cmpgt_epi64(min, x);
+	x = fix32__clamp_avx2(x, min, max);
+
+	__m256d xd = _mm256_mul_pd(fix32__small_to_pd_avx2(x), _mm256_set1_pd(1.0 / 4294967296.0));
+	__m256d n = _mm256_round_pd(_mm256_mul_pd(xd, _mm256_set1_pd(64.0)),
+	                            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	__m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(1.0 / 64), xd);
+	r = _mm256_mul_pd(r, _mm256_set1_pd(FIX32__LN2));
+
+	return fix32__exp_reduced_avx2(n, r, big, zero);
+}
+
+static inline __m256d fix32__ln_avx2(__m256i x)
+{
+	__m256i bits = _mm256_castpd_si256(fix32__positive_to_pd_avx2(x));
+	__m256d e = fix32__small_to_pd_avx2(_mm256_sub_epi64(_mm256_srli_epi64(bits, 52),
+	                                                     _mm256_set1_epi64x(1023 + 32)));
+	__m256i i = _mm256_and_si256(_mm256_srli_epi64(bits, 46), _mm256_set1_epi64x(63));
+	__m256d m = _mm256_castsi256_pd(_mm256_or_si256(
+		_mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFF)),
+		_mm256_set1_epi64x(0x3FF0000000000000)));
+
+	__m256d z = _mm256_fmsub_pd(m, _mm256_i64gather_pd(_fix32_ln_recip_d, i, 8), _mm256_set1_pd(1.0));
+	__m256d p = _mm256_set1_pd(1.0 / 7);
+	p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-1.0 / 6));
+	p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 5));
+	p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-1.0 / 4));
+	p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0 / 3));
+	p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(-1.0 / 2));
+	p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(1.0));
+	p = _mm256_fmadd_pd(p, z, _mm256_i64gather_pd(_fix32_ln_table_d, i, 8));
+
+	return _mm256_fmadd_pd(e, _mm256_set1_pd(FIX32__LN2), p);
+}
+
+static inline __m256i fix32__log_result_avx2(__m256i x, __m256d result)
+{
+	__m256i q = fix32__small_from_pd_avx2(_mm256_mul_pd(result, _mm256_set1_pd(4294967296.0)));
+	__m256i invalid = _mm256_cmpgt_epi64(_mm256_set1_epi64x(1), x);
+	return _mm256_blendv_epi8(q, _mm256_set1_epi64x(INT64_MIN), invalid);
+}
+
+static inline __m256i fix32__ln_q32_avx2(__m256i x)
+{
+	return fix32__log_result_avx2(x, fix32__ln_avx2(x));
+}
+
+static inline __m256i fix32__log2_q32_avx2(__m256i x)
+{
+	return fix32__log_result_avx2(x, _mm256_mul_pd(fix32__ln_avx2(x), _mm256_set1_pd(FIX32__LOG2_E)));
+}
+
+static inline void fix32__map_avx2(const fix32_t *inValues, fix32_t *outValues, size_t n,
+	__m256i (*kernel)(__m256i))
+{
+	size_t i;
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i *)(inValues + i));
+		_mm256_storeu_si256((__m256i *)(outValues + i), kernel(x));
+	}
+	if (i < n)
+	{
+		const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+		__m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n - i), lanes);
+		__m256i x = _mm256_maskload_epi64((const long long *)(inValues + i), mask);
+		_mm256_maskstore_epi64((long long *)(outValues + i), mask, kernel(x));
+	}
+}
+
+#define FIX32__EXPLOG_MAP(kernel) fix32__map_avx2(inValues, outValues, n, fix32__##kernel##_avx2)
+
+#endif
+
+void fix32_exp_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__EXPLOG_LANES
+	FIX32__EXPLOG_MAP(exp);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_exp(inValues[i]);
+	#endif
+}
+
+void fix32_ln_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__EXPLOG_LANES
+	FIX32__EXPLOG_MAP(ln_q32);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_ln(inValues[i]);
+	#endif
+}
+
+void fix32_log2_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__EXPLOG_LANES
+	FIX32__EXPLOG_MAP(log2_q32);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_log2(inValues[i]);
+	#endif
+}
+
+void fix32_pow2_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__EXPLOG_LANES
+	FIX32__EXPLOG_MAP(pow2);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_pow2(inValues[i]);
+	#endif
+}
+
+/* Square roots.
+ *
+ * The root is estimated in double precision lanes and rounded to an
+ * integer, which is within 1 of the result, and the remainder N - r^2,
+ * with N = x * 2^32 or x^2 + y^2, fixes the last bit the way fix32_sqrt
+ * does. The remainder is small, so its low 64 bits are enough and the
+ * squares only need 64 bit low products. This is exact as long as the
+ * estimate is within 1/2 of the root, which holds below 2^50; larger
+ * magnitudes go through fix32_hypot one lane at a time. So fix32_sqrt_array
+ * and fix32_magnitude_array give the same results as the scalar functions.
+ * fix32_rsqrt_array is the double estimate rounded, without a correction,
+ * so it is within 1 LSB of the exact value, like fix32_rsqrt.
+ */
+
+#if (defined(__AVX512F__) && defined(__AVX512DQ__)) || (defined(__AVX2__) && defined(__FMA__))
+#define FIX32__MAGNITUDE_LIMIT 1125899906842624.0   /* 2^50 */
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+
+#define FIX32__SQRT_LANES 8
+
+/* Moves the root estimate r to the result given the remainder N - r^2. */
+static inline __m512i fix32__sqrt_fix_avx512(__m512i r, __m512i rem)
+{
+	const __m512i one = _mm512_set1_epi64(1);
+#ifndef FIXMATH_NO_ROUNDING
+	__mmask8 up = _mm512_cmpgt_epi64_mask(rem, r);
+	// r - 1 is nearer when rem <= -r, except for a zero root.
+	__mmask8 down = _mm512_mask_cmpgt_epi64_mask(_mm512_test_epi64_mask(r, r), _mm512_sub_epi64(one, r), rem);
+#else
+	__mmask8 up = _mm512_cmpgt_epi64_mask(rem, _mm512_add_epi64(r, r));
+	__mmask8 down = _mm512_cmplt_epi64_mask(rem, _mm512_setzero_si512());
+#endif
+	r = _mm512_mask_add_epi64(r, up, r, one);
+	return _mm512_mask_sub_epi64(r, down, r, one);
+}
+
+static inline __m512i fix32__sqrt_avx512(__m512i x)
+{
+	__m512i num = _mm512_abs_epi64(x);
+	__m512d s = _mm512_sqrt_pd(_mm512_mul_pd(_mm512_cvtepu64_pd(num), _mm512_set1_pd(4294967296.0)));
+	__m512i r = _mm512_cvtpd_epi64(s);
+	__m512i rem = _mm512_sub_epi64(_mm512_slli_epi64(num, 32), _mm512_mullo_epi64(r, r));
+	r = fix32__sqrt_fix_avx512(r, rem);
+	__mmask8 neg = _mm512_cmplt_epi64_mask(x, _mm512_setzero_si512());
+	return _mm512_mask_sub_epi64(r, neg, _mm512_setzero_si512(), r);
+}
+
+/* 2^48 / sqrt(x), lanes with x <= 0 give fix32_overflow. */
+static inline __m512i fix32__rsqrt_avx512(__m512i x)
+{
+	__m512d s = _mm512_div_pd(_mm512_set1_pd(281474976710656.0), _mm512_sqrt_pd(_mm512_cvtepi64_pd(x)));
+	__mmask8 invalid = _mm512_cmple_epi64_mask(x, _mm512_setzero_si512());
+	return _mm512_mask_mov_epi64(_mm512_cvtpd_epi64(s), invalid, _mm512_set1_epi64(INT64_MIN));
+}
+
+/* Returns the magnitudes and sets *large to the lanes that need fix32_hypot. */
+static inline __m512i fix32__magnitude_avx512(__m512i x, __m512i y, __mmask8 *large)
+{
+	__m512d a = _mm512_cvtepi64_pd(x);
+	__m512d b = _mm512_cvtepi64_pd(y);
+	__m512d s = _mm512_sqrt_pd(_mm512_fmadd_pd(a, a, _mm512_mul_pd(b, b)));
+	*large = _mm512_cmp_pd_mask(s, _mm512_set1_pd(FIX32__MAGNITUDE_LIMIT), _CMP_GE_OQ);
+
+	__m512i r = _mm512_cvtpd_epi64(s);
+	__m512i rem = _mm512_sub_epi64(_mm512_add_epi64(_mm512_mullo_epi64(x, x), _mm512_mullo_epi64(y, y)),
+	                               _mm512_mullo_epi64(r, r));
+	return fix32__sqrt_fix_avx512(r, rem);
+}
+
+static inline void fix32__magnitude_store_avx512(__m512i x, __m512i y, fix32_t *outValues, __mmask8 mask)
+{
+	__mmask8 large;
+	__m512i r = fix32__magnitude_avx512(x, y, &large);
+	_mm512_mask_storeu_epi64(outValues, mask, r);
+	if (large)
+	{
+		// The inputs are taken from the registers, outValues may be re or im.
+		fix32_t xs[8], ys[8];
+		int j;
+		_mm512_storeu_si512((void *)xs, x);
+		_mm512_storeu_si512((void *)ys, y);
+		for (j = 0; j < 8; j++)
+		{
+			if (large & (1u << j))
+				outValues[j] = fix32_hypot(xs[j], ys[j]);
+		}
+	}
+}
+
+static inline void fix32__magnitude_map(const fix32_t *re, const fix32_t *im, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i + 8 <= n; i += 8)
+	{
+		__m512i x = _mm512_loadu_si512((const void *)(re + i));
+		__m512i y = _mm512_loadu_si512((const void *)(im + i));
+		fix32__magnitude_store_avx512(x, y, outValues + i, 0xFF);
+	}
+	if (i < n)
+	{
+		__mmask8 mask = (__mmask8)((1u << (n - i)) - 1);
+		__m512i x = _mm512_maskz_loadu_epi64(mask, re + i);
+		__m512i y = _mm512_maskz_loadu_epi64(mask, im + i);
+		fix32__magnitude_store_avx512(x, y, outValues + i, mask);
+	}
+}
+
+#define FIX32__SQRT_MAP(kernel) fix32__map_avx512(inValues, outValues, n, fix32__##kernel##_avx512)
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+#define FIX32__SQRT_LANES 4
+
+/* Low 64 bits of the lane products, from three 32 x 32 bit products. */
+static inline __m256i fix32__mullo_avx2(__m256i a, __m256i b)
+{
+	__m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+	                                 _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+	return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+}
+
+/* |x|, fix32_minimum gives 2^63 as unsigned. */
+static inline __m256i fix32__abs_avx2(__m256i x)
+{
+	__m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+	return _mm256_sub_epi64(_mm256_xor_si256(x, sign), sign);
+}
+
+/* See fix32__sqrt_fix_avx512. The masks are -1, so subtracting adds 1. */
+static inline __m256i fix32__sqrt_fix_avx2(__m256i r, __m256i rem)
+{
+#ifndef FIXMATH_NO_ROUNDING
+	__m256i up = _mm256_cmpgt_epi64(rem, r);
+	__m256i down = _mm256_andnot_si256(_mm256_cmpeq_epi64(r, _mm256_setzero_si256()),
+	                                   _mm256_cmpgt_epi64(_mm256_sub_epi64(_mm256_set1_epi64x(1), r), rem));
+#else
+	__m256i up = _mm256_cmpgt_epi64(rem, _mm256_add_epi64(r, r));
+	__m256i down = _mm256_cmpgt_epi64(_mm256_setzero_si256(), rem);
+#endif
+	return _mm256_add_epi64(_mm256_sub_epi64(r, up), down);
+}
+
+static inline __m256i fix32__sqrt_avx2(__m256i x)
+{
+	__m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+	__m256i num = _mm256_sub_epi64(_mm256_xor_si256(x, sign), sign);
+	__m256d s = _mm256_sqrt_pd(_mm256_mul_pd(fix32__positive_to_pd_avx2(num), _mm256_set1_pd(4294967296.0)));
+	__m256i r = fix32__small_from_pd_avx2(s);
+	__m256i rem = _mm256_sub_epi64(_mm256_slli_epi64(num, 32), fix32__mullo_avx2(r, r));
+	r = fix32__sqrt_fix_avx2(r, rem);
+	return _mm256_sub_epi64(_mm256_xor_si256(r, sign), sign);
+}
+
+/* See fix32__rsqrt_avx512. */
+static inline __m256i fix32__rsqrt_avx2(__m256i x)
+{
+	__m256d s = _mm256_div_pd(_mm256_set1_pd(281474976710656.0), _mm256_sqrt_pd(fix32__positive_to_pd_avx2(x)));
+	__m256i invalid = _mm256_cmpgt_epi64(_mm256_set1_epi64x(1), x);
+	return _mm256_blendv_epi8(fix32__small_from_pd_avx2(s), _mm256_set1_epi64x(INT64_MIN), invalid);
+}
+
+/* See fix32__magnitude_avx512, *large is a bit mask of the lanes. */
+static inline __m256i fix32__magnitude_avx2(__m256i x, __m256i y, int *large)
+{
+	__m256d a = fix32__positive_to_pd_avx2(fix32__abs_avx2(x));
+	__m256d b = fix32__positive_to_pd_avx2(fix32__abs_avx2(y));
+	__m256d s = _mm256_sqrt_pd(_mm256_fmadd_pd(a, a, _mm256_mul_pd(b, b)));
+	*large = _mm256_movemask_pd(_mm256_cmp_pd(s, _mm256_set1_pd(FIX32__MAGNITUDE_LIMIT), _CMP_GE_OQ));
+
+	__m256i r = fix32__small_from_pd_avx2(s);
+	__m256i rem = _mm256_sub_epi64(_mm256_add_epi64(fix32__mullo_avx2(x, x), fix32__mullo_avx2(y, y)),
+	                               fix32__mullo_avx2(r, r));
+	return fix32__sqrt_fix_avx2(r, rem);
+}
+
+static inline void fix32__magnitude_store_avx2(__m256i x, __m256i y, fix32_t *outValues, __m256i mask)
+{
+	int large;
+	__m256i r = fix32__magnitude_avx2(x, y, &large);
+	_mm256_maskstore_epi64((long long *)outValues, mask, r);
+	if (large)
+	{
+		// The inputs are taken from the registers, outValues may be re or im.
+		fix32_t xs[4], ys[4];
+		int j;
+		_mm256_storeu_si256((__m256i *)xs, x);
+		_mm256_storeu_si256((__m256i *)ys, y);
+		for (j = 0; j < 4; j++)
+		{
+			if (large & (1 << j))
+				outValues[j] = fix32_hypot(xs[j], ys[j]);
+		}
+	}
+}
+
+static inline void fix32__magnitude_map(const fix32_t *re, const fix32_t *im, fix32_t *outValues, size_t n)
+{
+	const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+	size_t i;
+	for (i = 0; i + 4 <= n; i += 4)
+	{
+		__m256i x = _mm256_loadu_si256((const __m256i *)(re + i));
+		__m256i y = _mm256_loadu_si256((const __m256i *)(im + i));
+		fix32__magnitude_store_avx2(x, y, outValues + i, _mm256_set1_epi64x(-1));
+	}
+	if (i < n)
+	{
+		__m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n - i), lanes);
+		__m256i x = _mm256_maskload_epi64((const long long *)(re + i), mask);
+		__m256i y = _mm256_maskload_epi64((const long long *)(im + i), mask);
+		fix32__magnitude_store_avx2(x, y, outValues + i, mask);
+	}
+}
+
+#define FIX32__SQRT_MAP(kernel) fix32__map_avx2(inValues, outValues, n, fix32__##kernel##_avx2)
+
+#endif
+
+void fix32_sqrt_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__SQRT_LANES
+	FIX32__SQRT_MAP(sqrt);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_sqrt(inValues[i]);
+	#endif
+}
+
+void fix32_rsqrt_array(const fix32_t *inValues, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__SQRT_LANES
+	FIX32__SQRT_MAP(rsqrt);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_rsqrt(inValues[i]);
+	#endif
+}
+
+void fix32_magnitude_array(const fix32_t *re, const fix32_t *im, fix32_t *outValues, size_t n)
+{
+	#ifdef FIX32__SQRT_LANES
+	fix32__magnitude_map(re, im, outValues, n);
+	#else
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32_hypot(re[i], im[i]);
+	#endif
+}
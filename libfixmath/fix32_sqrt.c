@@ -1,77 +1,418 @@
-#include "fix32.h"
-
-/* The square root algorithm is quite directly from
- * http://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Binary_numeral_system_.28base_2.29
- * An important difference is that it is split to two parts
- * in order to use only 64-bit operations.
- *
- * Note that for negative numbers we return -sqrt(-inValue).
- * Not sure if someone relies on this behaviour, but not going
- * to break it for now. It doesn't slow the code much overall.
- */
-fix32_t fix32_sqrt(fix32_t inValue)
-{
-	uint8_t  neg = (inValue < 0);
-	uint64_t num = (neg ? -inValue : inValue);
-	uint64_t result = 0;
-	uint64_t bit;
-	uint8_t  n;
-	
-	bit = (uint64_t)1 << 62;
-	
-	while (bit > num) bit >>= 2;
-	
-	// The main part is executed twice, in order to avoid
-	// > 64 bit values in computations.
-	for (n = 0; n < 2; n++)
-	{
-		// First we get the top 24 bits of the answer.
-		while (bit)
-		{
-			if (num >= result + bit)
-			{
-				num -= result + bit;
-				result = (result >> 1) + bit;
-			}
-			else
-			{
-				result = (result >> 1);
-			}
-			bit >>= 2;
-		}
-		
-		if (n == 0)
-		{
-			// Then process it again to get the lowest bits.
-			if (num > 4294967295)
-			{
-				// The remainder 'num' is too large to be shifted left
-				// by 32, so we have to add 1 to result manually and
-				// adjust 'num' accordingly.
-				// num = a - (result + 0.5)^2
-				//	 = num + result^2 - (result + 0.5)^2
-				//	 = num - result - 0.5
-				num -= result;
-				num = (num << 32) - 0x80000000;
-				result = (result << 32) + 0x80000000;
-			}
-			else
-			{
-				num <<= 32;
-				result <<= 32;
-			}
-			
-			bit = 1 << 30;
-		}
-	}
-
-#ifndef FIXMATH_NO_ROUNDING
-	// Finally, if next bit would have been 1, round the result upwards.
-	if (num > result)
-	{
-		result++;
-	}
-#endif
-	
-	return (neg ? -(fix32_t)result : (fix32_t)result);
-}
+#include "fix32.h"
+#include "fix32_internal.h"
+
+/* Square roots.
+ *
+ * x = M * 2^e with M = [1, 4) and e even, so that sqrt(x) = sqrt(M) * 2^(e/2).
+ * 1/sqrt(M) is seeded from the table below and refined with Newton's
+ * iteration r = r * (3 - M * r^2) / 2, which needs no division. Each step
+ * doubles the number of correct bits. Finally sqrt(M) = M * r.
+ *
+ * Note that for negative numbers we return -sqrt(-inValue).
+ * Not sure if someone relies on this behaviour, but not going
+ * to break it for now.
+ */
+
+/* 1/sqrt(M) in Q16 for M = [1, 2) in steps of 1/128 and M = [2, 4) in steps
+ * of 1/64, at most 2^-9 relative error.
+ */
+static const uint16_t _fix32_rsqrt_seed[256] = {
+	0xFF81, 0xFE84, 0xFD8A, 0xFC92, 0xFB9E, 0xFAAC, 0xF9BD, 0xF8D1, 0xF7E7, 0xF700, 0xF61B, 0xF539, 0xF459, 0xF37C, 0xF2A1, 0xF1C8,
+	0xF0F1, 0xF01D, 0xEF4B, 0xEE7B, 0xEDAD, 0xECE1, 0xEC17, 0xEB4F, 0xEA8A, 0xE9C6, 0xE904, 0xE844, 0xE785, 0xE6C9, 0xE60E, 0xE555,
+	0xE49E, 0xE3E9, 0xE335, 0xE283, 0xE1D2, 0xE123, 0xE076, 0xDFCA, 0xDF20, 0xDE77, 0xDDD0, 0xDD2A, 0xDC86, 0xDBE3, 0xDB41, 0xDAA1,
+	0xDA02, 0xD965, 0xD8C9, 0xD82E, 0xD794, 0xD6FC, 0xD665, 0xD5CF, 0xD53B, 0xD4A8, 0xD415, 0xD384, 0xD2F5, 0xD266, 0xD1D8, 0xD14C,
+	0xD0C1, 0xD036, 0xCFAD, 0xCF25, 0xCE9E, 0xCE18, 0xCD93, 0xCD0F, 0xCC8C, 0xCC09, 0xCB88, 0xCB08, 0xCA89, 0xCA0B, 0xC98D, 0xC911,
+	0xC895, 0xC81A, 0xC7A1, 0xC728, 0xC6B0, 0xC638, 0xC5C2, 0xC54C, 0xC4D7, 0xC463, 0xC3F0, 0xC37E, 0xC30C, 0xC29B, 0xC22B, 0xC1BC,
+	0xC14D, 0xC0E0, 0xC072, 0xC006, 0xBF9A, 0xBF2F, 0xBEC5, 0xBE5C, 0xBDF3, 0xBD8A, 0xBD23, 0xBCBC, 0xBC56, 0xBBF0, 0xBB8B, 0xBB27,
+	0xBAC3, 0xBA60, 0xB9FD, 0xB99C, 0xB93A, 0xB8DA, 0xB87A, 0xB81A, 0xB7BB, 0xB75D, 0xB6FF, 0xB6A2, 0xB645, 0xB5E9, 0xB58D, 0xB532,
+	0xB4AB, 0xB3F8, 0xB347, 0xB298, 0xB1EB, 0xB141, 0xB098, 0xAFF0, 0xAF4B, 0xAEA8, 0xAE06, 0xAD66, 0xACC8, 0xAC2B, 0xAB90, 0xAAF7,
+	0xAA5F, 0xA9C9, 0xA934, 0xA8A1, 0xA810, 0xA780, 0xA6F1, 0xA664, 0xA5D8, 0xA54D, 0xA4C4, 0xA43C, 0xA3B6, 0xA330, 0xA2AC, 0xA22A,
+	0xA1A8, 0xA128, 0xA0A9, 0xA02B, 0x9FAE, 0x9F32, 0x9EB8, 0x9E3E, 0x9DC6, 0x9D4E, 0x9CD8, 0x9C63, 0x9BEF, 0x9B7C, 0x9B09, 0x9A98,
+	0x9A28, 0x99B8, 0x994A, 0x98DD, 0x9870, 0x9804, 0x979A, 0x9730, 0x96C7, 0x965F, 0x95F7, 0x9591, 0x952B, 0x94C6, 0x9462, 0x93FF,
+	0x939C, 0x933A, 0x92D9, 0x9279, 0x921A, 0x91BB, 0x915D, 0x90FF, 0x90A3, 0x9047, 0x8FEB, 0x8F91, 0x8F37, 0x8EDD, 0x8E85, 0x8E2D,
+	0x8DD5, 0x8D7F, 0x8D28, 0x8CD3, 0x8C7E, 0x8C2A, 0x8BD6, 0x8B83, 0x8B30, 0x8ADE, 0x8A8D, 0x8A3C, 0x89EB, 0x899C, 0x894C, 0x88FE,
+	0x88AF, 0x8862, 0x8815, 0x87C8, 0x877C, 0x8730, 0x86E5, 0x869A, 0x8650, 0x8607, 0x85BD, 0x8575, 0x852C, 0x84E4, 0x849D, 0x8456,
+	0x8410, 0x83C9, 0x8384, 0x833F, 0x82FA, 0x82B5, 0x8272, 0x822E, 0x81EB, 0x81A8, 0x8166, 0x8124, 0x80E2, 0x80A1, 0x8060, 0x8020
+	};
+
+/* 1/cbrt(M) in Q16 for M = [1, 2), [2, 4) and [4, 8), 64 steps each, at
+ * most 2^-8.5 relative error.
+ */
+static const uint16_t _fix32_cbrt_seed[192] = {
+	0xFF56, 0xFE08, 0xFCC0, 0xFB7F, 0xFA44, 0xF910, 0xF7E1, 0xF6B7, 0xF594, 0xF475, 0xF35C, 0xF248, 0xF138, 0xF02D, 0xEF27, 0xEE26,
+	0xED28, 0xEC2F, 0xEB39, 0xEA48, 0xE95B, 0xE871, 0xE78A, 0xE6A8, 0xE5C9, 0xE4ED, 0xE414, 0xE33F, 0xE26C, 0xE19D, 0xE0D0, 0xE007,
+	0xDF40, 0xDE7C, 0xDDBA, 0xDCFC, 0xDC3F, 0xDB86, 0xDACE, 0xDA19, 0xD967, 0xD8B6, 0xD808, 0xD75C, 0xD6B2, 0xD60A, 0xD564, 0xD4C1,
+	0xD41F, 0xD37F, 0xD2E1, 0xD245, 0xD1AA, 0xD111, 0xD07A, 0xCFE5, 0xCF51, 0xCEBF, 0xCE2F, 0xCDA0, 0xCD13, 0xCC87, 0xCBFD, 0xCB74,
+	0xCAA9, 0xC9A0, 0xC89C, 0xC79D, 0xC6A3, 0xC5AE, 0xC4BE, 0xC3D2, 0xC2EA, 0xC207, 0xC128, 0xC04C, 0xBF75, 0xBEA1, 0xBDD1, 0xBD04,
+	0xBC3B, 0xBB75, 0xBAB3, 0xB9F3, 0xB936, 0xB87D, 0xB7C6, 0xB712, 0xB661, 0xB5B3, 0xB507, 0xB45D, 0xB3B6, 0xB312, 0xB26F, 0xB1CF,
+	0xB132, 0xB096, 0xAFFC, 0xAF65, 0xAED0, 0xAE3C, 0xADAB, 0xAD1B, 0xAC8D, 0xAC01, 0xAB77, 0xAAEE, 0xAA67, 0xA9E2, 0xA95F, 0xA8DD,
+	0xA85C, 0xA7DD, 0xA760, 0xA6E4, 0xA669, 0xA5F0, 0xA578, 0xA502, 0xA48C, 0xA419, 0xA3A6, 0xA335, 0xA2C4, 0xA255, 0xA1E8, 0xA17B,
+	0xA0DA, 0xA008, 0x9F39, 0x9E6F, 0x9DA8, 0x9CE6, 0x9C27, 0x9B6C, 0x9AB4, 0x9A00, 0x994F, 0x98A0, 0x97F5, 0x974D, 0x96A8, 0x9606,
+	0x9566, 0x94C9, 0x942F, 0x9397, 0x9301, 0x926E, 0x91DD, 0x914E, 0x90C1, 0x9037, 0x8FAE, 0x8F28, 0x8EA3, 0x8E20, 0x8DA0, 0x8D21,
+	0x8CA3, 0x8C28, 0x8BAE, 0x8B36, 0x8ABF, 0x8A4A, 0x89D7, 0x8965, 0x88F4, 0x8885, 0x8817, 0x87AB, 0x8740, 0x86D6, 0x866E, 0x8607,
+	0x85A1, 0x853C, 0x84D8, 0x8476, 0x8415, 0x83B4, 0x8355, 0x82F7, 0x829A, 0x823E, 0x81E3, 0x8189, 0x8130, 0x80D8, 0x8081, 0x802B
+	};
+
+/* Returns 1/sqrt(M) in Q30 after the given number of Newton steps in Q30,
+ * for m = M in unsigned Q62, M = [1, 4). One step gives 17 bits, two give
+ * 28 bits, which is the limit of the Q30 arithmetic.
+ */
+static inline int64_t fix32__rsqrt_q30(uint64_t m, int steps)
+{
+	unsigned upper = (unsigned)(m >> 63);
+	int64_t r = (int64_t)_fix32_rsqrt_seed[(upper << 7) | ((m >> (55 + upper)) & 127)] << 14;
+
+	int64_t M = (int64_t)(m >> 32);
+	while (steps--)
+	{
+		int64_t r2 = (r * r) >> 30;
+		r = (r * (((int64_t)3 << 30) - ((M * r2) >> 30))) >> 31;
+	}
+	return r;
+}
+
+/* Returns 1/sqrt(M) in unsigned Q62, M = [1, 4) as m in Q62, with a third
+ * Newton step in Q62. The relative error is below 2^-55.
+ */
+static inline uint64_t fix32__rsqrt_q62(uint64_t m)
+{
+	uint64_t r = (uint64_t)fix32__rsqrt_q30(m, 2) << 32;
+	uint64_t h = fix32__umul_shr(m, fix32__umul_shr(r, r, 62), 62);
+	return fix32__umul_shr(r, ((uint64_t)3 << 62) - h, 63);
+}
+
+/* The result is round(sqrt(x * 2^32)), computed exactly: the Q62 estimate
+ * is within 1 of the root, and the remainder x * 2^32 - root^2 fixes the
+ * last bit. Only its low 64 bits are needed, as it is small.
+ */
+fix32_t fix32_sqrt(fix32_t inValue)
+{
+	uint8_t  neg = (inValue < 0);
+	uint64_t num = (neg ? -(uint64_t)inValue : (uint64_t)inValue);
+
+	if (num == 0)
+		return 0;
+
+	int shift = clz(num) & ~1;
+	uint64_t m = num << shift;
+
+	// sqrt(M) in Q62 is sqrt(num * 2^32) * 2^(15 + shift/2).
+	uint64_t result = fix32__umul_shr(m, fix32__rsqrt_q62(m), 62) >> (15 + shift / 2);
+	int64_t rem = (int64_t)((num << 32) - result * result);
+	while (rem < 0)
+	{
+		result--;
+		rem += 2 * result + 1;
+	}
+	while (rem > (int64_t)(2 * result))
+	{
+		rem -= 2 * result + 1;
+		result++;
+	}
+
+#ifndef FIXMATH_NO_ROUNDING
+	// Round to nearest, (result + 1/2)^2 = result^2 + result + 1/4.
+	if (rem > (int64_t)result)
+	{
+		result++;
+	}
+#endif
+
+	return (neg ? -(fix32_t)result : (fix32_t)result);
+}
+
+/* 1/sqrt(x) = 1/sqrt(M) * 2^(shift/2 - 15), rounded from Q62. */
+fix32_t fix32_rsqrt(fix32_t inValue)
+{
+	if (inValue <= 0)
+		return fix32_overflow;
+
+	int shift = clz((uint64_t)inValue) & ~1;
+	int right = 45 - shift / 2;
+	uint64_t r = fix32__rsqrt_q62((uint64_t)inValue << shift);
+	return (fix32_t)((r + ((uint64_t)1 << (right - 1))) >> right);
+}
+
+/* Sum of squares of count values in 128 bits, Q64. It fits for up to
+ * four components, even at fix32_minimum.
+ */
+static inline void fix32__sum_squares(const fix32_t *v, int count, uint64_t *hi, uint64_t *lo)
+{
+	int i;
+	*hi = 0;
+	*lo = 0;
+	for (i = 0; i < count; i++)
+	{
+		uint64_t a = (v[i] < 0 ? -(uint64_t)v[i] : (uint64_t)v[i]);
+		uint64_t sq_hi, sq_lo = fix32__umul128(a, a, &sq_hi);
+		*lo += sq_lo;
+		*hi += sq_hi + (*lo < sq_lo);
+	}
+}
+
+/* Normalizes a nonzero 128 bit value with an even shift k, returned, and
+ * stores its top 64 bits to *m, which is then M = [1, 4) in Q62.
+ */
+static inline int fix32__norm128(uint64_t hi, uint64_t lo, uint64_t *m)
+{
+	int k = (hi ? clz(hi) : 64 + clz(lo)) & ~1;
+	if (k >= 64)
+		*m = lo << (k - 64);
+	else if (k == 0)
+		*m = hi;
+	else
+		*m = (hi << k) | (lo >> (64 - k));
+	return k;
+}
+
+/* The sum of squares is kept in 128 bits, so that no component can
+ * overflow it. With the sum normalized to M * 2^(126 - k),
+ * 1/|v| = 1/sqrt(M) * 2^(k/2 - 31).
+ */
+static void fix32__normalize(fix32_t *v, int count)
+{
+	uint64_t hi, lo, m;
+	fix32__sum_squares(v, count, &hi, &lo);
+	if (hi == 0 && lo == 0)
+		return;
+
+	int k = fix32__norm128(hi, lo, &m);
+	int64_t r = (int64_t)fix32__rsqrt_q62(m);
+	int shift = 93 - k / 2;
+	int i;
+	for (i = 0; i < count; i++)
+		v[i] = (fix32__mul_shr(v[i], r, shift - 1) + 1) >> 1;
+}
+
+void fix32_normalize2(fix32_t *x, fix32_t *y)
+{
+	fix32_t v[2] = { *x, *y };
+	fix32__normalize(v, 2);
+	*x = v[0];
+	*y = v[1];
+}
+
+void fix32_normalize3(fix32_t *x, fix32_t *y, fix32_t *z)
+{
+	fix32_t v[3] = { *x, *y, *z };
+	fix32__normalize(v, 3);
+	*x = v[0];
+	*y = v[1];
+	*z = v[2];
+}
+
+/* Returns the square root of the sum of squares, which is the 128 bit
+ * Q64 value S, in Q32. S is normalized as above and the root estimate
+ * sqrt(M) * 2^(63 - k/2) from the Q62 kernel is within a few hundred
+ * units for large S. One Newton step root += (S - root^2) / (2 * root),
+ * with the division done by the reciprocal root we already have, brings
+ * it within a unit, and comparing root^2 with S finishes it exactly.
+ */
+static fix32_t fix32__hypot(const fix32_t *v, int count)
+{
+	uint64_t hi, lo, m;
+	fix32__sum_squares(v, count, &hi, &lo);
+	if (hi == 0 && lo == 0)
+		return 0;
+
+	// The root is 2^63 or more.
+	if (hi >> 62)
+		return fix32_maximum;
+
+	int k = fix32__norm128(hi, lo, &m);
+	uint64_t r = fix32__rsqrt_q62(m);
+	uint64_t root = fix32__umul_shr(m, r, 62) >> (k / 2 - 1);
+
+	// The remainder is within 2^80, so dropping 16 bits makes it fit in
+	// 64 bits and costs nothing in the correction.
+	uint64_t sq_hi, sq_lo = fix32__umul128(root, root, &sq_hi);
+	uint64_t rem_hi = hi - sq_hi - (lo < sq_lo);
+	uint64_t rem_lo = lo - sq_lo;
+	int64_t rem = (int64_t)((rem_hi << 48) | (rem_lo >> 16));
+	root += fix32__mul_shr(rem, (int64_t)r, 110 - k / 2);
+
+	// Now root^2 <= S < (root + 1)^2.
+	for (;;)
+	{
+		sq_lo = fix32__umul128(root, root, &sq_hi);
+		if (sq_hi < hi || (sq_hi == hi && sq_lo <= lo))
+			break;
+		root--;
+	}
+	for (;;)
+	{
+		sq_lo = fix32__umul128(root + 1, root + 1, &sq_hi);
+		if (sq_hi > hi || (sq_hi == hi && sq_lo > lo))
+			break;
+		root++;
+	}
+
+#ifndef FIXMATH_NO_ROUNDING
+	// Round to nearest, S > (root + 1/2)^2 iff S > root * (root + 1).
+	sq_lo = fix32__umul128(root, root + 1, &sq_hi);
+	if (sq_hi < hi || (sq_hi == hi && sq_lo < lo))
+	{
+		root++;
+	}
+#endif
+
+	return (root > (uint64_t)fix32_maximum ? fix32_maximum : (fix32_t)root);
+}
+
+fix32_t fix32_hypot(fix32_t x, fix32_t y)
+{
+	fix32_t v[2] = { x, y };
+	return fix32__hypot(v, 2);
+}
+
+fix32_t fix32_hypot3(fix32_t x, fix32_t y, fix32_t z)
+{
+	fix32_t v[3] = { x, y, z };
+	return fix32__hypot(v, 3);
+}
+
+void fix32_hypot_array(const fix32_t *inPairs, fix32_t *outValues, size_t n)
+{
+	size_t i;
+	for (i = 0; i < n; i++)
+		outValues[i] = fix32__hypot(inPairs + 2 * i, 2);
+}
+
+/* Returns a 128 bit r^3, for r < 2^43, and stores the high word to *hi. */
+static inline uint64_t fix32__cube128(uint64_t r, uint64_t *hi)
+{
+	uint64_t sq_hi, sq_lo = fix32__umul128(r, r, &sq_hi);
+	uint64_t lo = fix32__umul128(sq_lo, r, hi);
+	*hi += sq_hi * r;
+	return lo;
+}
+
+/* Returns round(cbrt(num * 2^64)), or rounded down with FIXMATH_NO_ROUNDING,
+ * from an estimate within one unit of it.
+ */
+static uint64_t fix32__cbrt_exact(uint64_t num, uint64_t result)
+{
+	// First result^3 <= num * 2^64 < (result + 1)^3.
+	uint64_t cube_hi, cube_lo;
+	for (;;)
+	{
+		cube_lo = fix32__cube128(result, &cube_hi);
+		if (cube_hi < num || (cube_hi == num && cube_lo == 0))
+			break;
+		result--;
+	}
+	for (;;)
+	{
+		uint64_t next_hi, next_lo = fix32__cube128(result + 1, &next_hi);
+		if (next_hi > num || (next_hi == num && next_lo > 0))
+			break;
+		result++;
+		cube_hi = next_hi;
+		cube_lo = next_lo;
+	}
+
+#ifndef FIXMATH_NO_ROUNDING
+	// Round to nearest, x > (result + 1/2)^3 iff
+	// 4 * (x - result^3) > 3 * result * (2 * result + 1).
+	uint64_t rem_hi = num - cube_hi - (cube_lo != 0);
+	uint64_t rem_lo = 0 - cube_lo;
+	uint64_t lim_hi, lim_lo = fix32__umul128(3 * result, 2 * result + 1, &lim_hi);
+	rem_hi = (rem_hi << 2) | (rem_lo >> 62);
+	rem_lo <<= 2;
+	if (rem_hi > lim_hi || (rem_hi == lim_hi && rem_lo > lim_lo))
+	{
+		result++;
+	}
+#endif
+
+	return result;
+}
+
+/* Cube roots, the result is round(cbrt(|x| * 2^64)) and exact like
+ * fix32_sqrt. |x| * 2^64 = M * 2^t * 2^(3 * k) with M = [1, 2) and
+ * t = [0, 3). r = 1/cbrt(M * 2^t) is seeded from the table and refined
+ * without division, with d = 1 - M * 2^t * r^3: twice with Newton's
+ * r = r * (1 + d / 3) in Q30, to 2^-27, and once with the second order
+ * r = r * (1 + d / 3 + 2 * d^2 / 9) in Q62, to the limit of the
+ * arithmetic. The root M * 2^t * r^2 * 2^k then has 16 more bits, which
+ * decide the rounding unless they are too close to the midpoint. Only
+ * then are the cubes compared.
+ */
+fix32_t fix32_cbrt(fix32_t inValue)
+{
+	uint8_t  neg = (inValue < 0);
+	uint64_t num = (neg ? -(uint64_t)inValue : (uint64_t)inValue);
+
+	if (num == 0)
+		return 0;
+
+	int shift = clz(num);
+	uint64_t m = num << shift;
+	int e = 127 - shift;
+	int t = e % 3;
+	int k = e / 3;
+
+	int64_t r = (int64_t)_fix32_cbrt_seed[(t << 6) | ((m >> 57) & 63)] << 14;
+	int64_t M = (int64_t)(m >> 33) << t;
+	int i;
+	for (i = 0; i < 2; i++)
+	{
+		int64_t r3 = (((r * r) >> 30) * r) >> 30;
+		r += ((r * (((int64_t)1 << 30) - ((M * r3) >> 30))) >> 30) / 3;
+	}
+
+	uint64_t r62 = (uint64_t)r << 32;
+	uint64_t r2 = fix32__umul_shr(r62, r62, 62);
+	int64_t d = ((int64_t)1 << 62) - (int64_t)fix32__umul_shr(m, fix32__umul_shr(r2, r62, 62), 63 - t);
+	int64_t d3 = d / 3;
+	r62 += fix32__mul_shr((int64_t)r62, d3 + (fix32__mul_shr(d3, d3, 62) << 1), 62);
+
+	// cbrt(M * 2^t) in Q62 is [1, 2), the root is below 2^43.
+	uint64_t root = fix32__umul_shr(m, fix32__umul_shr(r62, r62, 62), 63 - t) >> (46 - k);
+#ifndef FIXMATH_NO_ROUNDING
+	root += 0x8000;
+#endif
+	uint64_t result = root >> 16;
+
+	// The error of root is below 2^-54 relative plus 2 units, the margin
+	// is four times that.
+	uint64_t margin = (root >> 52) + 8;
+	if (((root + margin) & 0xFFFF) <= 2 * margin)
+		result = fix32__cbrt_exact(num, result);
+
+	return (neg ? -(fix32_t)result : (fix32_t)result);
+}
+
+/* Reduced precision square roots, see fix32.h for the tiers. One Newton
+ * step gives the fast tier and two the mid tier.
+ */
+static fix32_t fix32__sqrt_tier(fix32_t inValue, int steps)
+{
+	uint8_t  neg = (inValue < 0);
+	uint64_t num = (neg ? -(uint64_t)inValue : (uint64_t)inValue);
+
+	if (num == 0)
+		return 0;
+
+	int shift = clz(num) & ~1;
+	uint64_t m = num << shift;
+	int64_t M = (int64_t)(m >> 32);
+
+	// sqrt(M) in Q30, to Q32 and scaled by 2^(15 - shift/2).
+	int64_t root = (M * fix32__rsqrt_q30(m, steps)) >> 30;
+	int scale = 17 - shift / 2;
+	fix32_t result = (scale >= 0) ? root << scale
+	                              : (root + ((int64_t)1 << (-scale - 1))) >> -scale;
+
+	return (neg ? -result : result);
+}
+
+fix32_t fix32_sqrt_fast(fix32_t inValue)
+{
+	return fix32__sqrt_tier(inValue, 1);
+}
+
+fix32_t fix32_sqrt_mid(fix32_t inValue)
+{
+	return fix32__sqrt_tier(inValue, 2);
+}
@@ -0,0 +1,575 @@
+#include "fix32.h"
+#include "fix32_internal.h"
+#include <stdbool.h>
+#include <string.h>
+#ifndef FIXMATH_NO_CTYPE
+#include <ctype.h>
+#else
+static inline int isdigit(int c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static inline int isspace(int c)
+{
+	return c == ' ' || c == '\r' || c == '\n' || c == '\t' || c == '\v' || c == '\f';
+}
+#endif
+
+/* String conversions, with integer arithmetic only.
+ *
+ * A Q32 fraction has a finite decimal expansion of at most 32 digits, so
+ * formatting produces the exact digits and rounds the rest. Parsing needs
+ * round(F * 2^32 / 10^k) for the k fraction digits F, which is a
+ * multiplication by a reciprocal of 10^k and an exact remainder check for
+ * up to 18 digits. Longer inputs only matter near a rounding boundary, and
+ * there the digits are compared with the exact decimal expansion of the
+ * boundary.
+ */
+
+/* 10^k and floor(2^(64 + e) / 10^k), where 2^e <= 10^k < 2^(e + 1), for
+ * k = 1..18. The product with F shifted right by 32 + e is
+ * floor(F * 2^32 / 10^k) or one less. Entry 0 is not used.
+ */
+static const uint64_t _fix32_pow10[19] = {
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+	100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL
+};
+
+static const uint64_t _fix32_pow10_recip[19] = {
+	0,
+	0xcccccccccccccccc, 0xa3d70a3d70a3d70a, 0x83126e978d4fdf3b,
+	0xd1b71758e219652b, 0xa7c5ac471b478423, 0x8637bd05af6c69b5,
+	0xd6bf94d5e57a42bc, 0xabcc77118461cefc, 0x89705f4136b4a597,
+	0xdbe6fecebdedd5be, 0xafebff0bcb24aafe, 0x8cbccc096f5088cb,
+	0xe12e13424bb40e13, 0xb424dc35095cd80f, 0x901d7cf73ab0acd9,
+	0xe69594bec44de15b, 0xb877aa3236a4b449, 0x9392ee8e921d5d07
+};
+
+static const uint8_t _fix32_pow10_shift[19] = {
+	0, 35, 38, 41, 45, 48, 51, 55, 58, 61, 65, 68, 71, 75, 78, 81, 85, 88, 91
+};
+
+/* Compares the decimal fraction 0.d1d2...dcount with mid / 2^33, mid may
+ * be 2^33 or more. The digits of the boundary come out of the binary
+ * fraction one at a time, multiplying by 10, and end after 33 of them.
+ */
+static int fix32__cmp_digits(const char *digits, int count, uint64_t mid)
+{
+	const uint64_t mask = ((uint64_t)1 << 33) - 1;
+	int i;
+
+	if (mid > mask)
+		return -1;
+
+	for (i = 0; i < count; i++)
+	{
+		mid *= 10;
+		int d = (int)(mid >> 33);
+		mid &= mask;
+		if (digits[i] - '0' != d)
+			return (digits[i] - '0' < d) ? -1 : 1;
+	}
+	return (mid != 0) ? -1 : 0;
+}
+
+/* Returns the k digit fraction f / 10^k in Q32 rounded down, 0 < k <= 18,
+ * and the remainder to *rem.
+ */
+static inline uint64_t fix32__floor_digits(uint64_t f, int k, uint64_t *rem)
+{
+	// The remainder is below 2 * 10^18, so it is exact in 64 bits.
+	uint64_t q = fix32__umul_shr(f, _fix32_pow10_recip[k], _fix32_pow10_shift[k]);
+	uint64_t r = (f << 32) - q * _fix32_pow10[k];
+	if (r >= _fix32_pow10[k])
+	{
+		q++;
+		r -= _fix32_pow10[k];
+	}
+	*rem = r;
+	return q;
+}
+
+/* The same rounded to nearest, ties to even. */
+static inline uint64_t fix32__round_digits(uint64_t f, int k)
+{
+	uint64_t rem, q = fix32__floor_digits(f, k, &rem);
+#ifndef FIXMATH_NO_ROUNDING
+	uint64_t twice = 2 * rem;
+	q += (twice > _fix32_pow10[k]) | ((twice == _fix32_pow10[k]) & q);
+#endif
+	return q;
+}
+
+/* Returns the fraction digits rounded to Q32, which is 2^32 when they
+ * round up to 1. f is the value of the first min(count, 18) digits.
+ */
+static uint64_t fix32__round_fraction(uint64_t f, const char *digits, int count)
+{
+	if (count == 0)
+		return 0;
+	if (count <= 18)
+		return fix32__round_digits(f, count);
+
+	uint64_t rem, q = fix32__floor_digits(f, 18, &rem);
+
+	// The digits after the 18th add less than one unit, so the result is
+	// q, q + 1 or q + 2 (rounded down q or q + 1). The boundaries between
+	// them are (2q + 1) / 2^33 and (2q + 3) / 2^33.
+#ifndef FIXMATH_NO_ROUNDING
+	int c = fix32__cmp_digits(digits, count, 2 * q + 1);
+	if (c < 0)
+		return q;
+	if (c == 0)
+		return q + (q & 1);
+	c = fix32__cmp_digits(digits, count, 2 * q + 3);
+	if (c < 0)
+		return q + 1;
+	if (c == 0)
+		return q + 1 + ((q + 1) & 1);
+	return q + 2;
+#else
+	return q + (fix32__cmp_digits(digits, count, 2 * q + 2) >= 0);
+#endif
+}
+
+/* Writes the decimal digits of an integer part, at most 2^31. */
+static inline char *fix32__put_uint(char *buf, uint64_t value)
+{
+	char digits[10];
+	int n = 0;
+
+	do
+	{
+		digits[n++] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value);
+	while (n > 0)
+		*buf++ = digits[--n];
+	return buf;
+}
+
+/* Writes the value with the given number of decimals and the terminator,
+ * returns the position of the terminator.
+ */
+static char *fix32__format(fix32_t value, char *buf, int decimals)
+{
+	uint64_t neg = (uint64_t)value >> 63;
+	uint64_t mag = ((uint64_t)value ^ -neg) + neg;
+	uint64_t intpart = mag >> 32;
+	uint64_t rem = mag & 0xFFFFFFFF;
+	char frac[32];
+	int i;
+
+	if (decimals < 0)
+		decimals = 0;
+	if (decimals > 32)
+		decimals = 32;
+
+	// Exact digits, each one is the integer part of the fraction times 10.
+	for (i = 0; i < decimals; i++)
+	{
+		rem *= 10;
+		frac[i] = (char)('0' + (rem >> 32));
+		rem &= 0xFFFFFFFF;
+	}
+
+	// Round the rest to nearest, ties to even, like printf.
+	int last = (decimals > 0) ? frac[decimals - 1] : (int)intpart;
+	if (rem > 0x80000000 || (rem == 0x80000000 && (last & 1)))
+	{
+		for (i = decimals - 1; i >= 0 && frac[i] == '9'; i--)
+			frac[i] = '0';
+		if (i >= 0)
+			frac[i]++;
+		else
+			intpart++;
+	}
+
+	if (neg)
+		*buf++ = '-';
+	buf = fix32__put_uint(buf, intpart);
+
+	if (decimals > 0)
+	{
+		*buf++ = '.';
+		for (i = 0; i < decimals; i++)
+			*buf++ = frac[i];
+	}
+
+	*buf = '\0';
+	return buf;
+}
+
+void fix32_to_str(fix32_t value, char *buf, int decimals)
+{
+	fix32__format(value, buf, decimals);
+}
+
+/* Shortest formatting.
+ *
+ * The strings that parse back to a fraction F / 2^32 are those in its
+ * rounding interval, F / 2^32 +- 1 / 2^33 with the ends included for even
+ * F, or F / 2^32 up to (F + 1) / 2^32 when parsing truncates. Like Ryu,
+ * the digits are generated until the interval contains a k digit decimal,
+ * and of those the closest one to the value is written. That is the k
+ * digits so far or one more in the last digit: scaled by 10^k, the
+ * interval reaches from the value down to the digits so far, or up to the
+ * next decimal. It is wider than 10^-10, so k is at most 10.
+ */
+
+/* "-2147483647.9999999998" and the terminator. */
+#define FIX32__SHORTEST_SIZE 23
+
+static char *fix32__format_shortest(fix32_t value, char *buf)
+{
+	// The fraction and the distances to the ends of the interval are
+	// fractions of 2^33, the distances scaled by 10^k like the fraction.
+	const uint64_t one = (uint64_t)1 << 33;
+	uint64_t neg = (uint64_t)value >> 63;
+	uint64_t mag = ((uint64_t)value ^ -neg) + neg;
+	uint64_t x = 2 * (mag & 0xFFFFFFFF);
+
+	if (neg)
+		*buf++ = '-';
+	buf = fix32__put_uint(buf, mag >> 32);
+	if (x == 0)
+	{
+		*buf = '\0';
+		return buf;
+	}
+
+#ifndef FIXMATH_NO_ROUNDING
+	uint64_t below = 1, above = 1;
+	uint64_t even = ((x & 2) == 0);
+	uint64_t below_in = even, above_in = even;
+#else
+	uint64_t below = 0, above = 2;
+	uint64_t below_in = 1, above_in = 0;
+#endif
+	uint64_t down, up;
+
+	*buf++ = '.';
+	do
+	{
+		x *= 10;
+		below *= 10;
+		above *= 10;
+		*buf++ = (char)('0' + (x >> 33));
+		x &= one - 1;
+
+		// Whether the digits so far, or one more, parse back.
+		down = (x < below) | ((x == below) & below_in);
+		up = (one - x < above) | ((one - x == above) & above_in);
+	} while (!(down | up));
+
+	// The nearest, ties to even, unless only the other one parses back.
+	uint64_t round_up = (x > one / 2) | ((x == one / 2) & (buf[-1] & 1));
+	round_up = (round_up & up) | !down;
+	if (round_up)
+	{
+		// The interval ends before the next integer, so this carry
+		// stops within the fraction.
+		char *p = buf - 1;
+		while (*p == '9')
+			*p-- = '0';
+		(*p)++;
+	}
+
+	*buf = '\0';
+	return buf;
+}
+
+void fix32_to_str_shortest(fix32_t value, char *buf)
+{
+	fix32__format_shortest(value, buf);
+}
+
+size_t fix32_format_array(const fix32_t *values, size_t count, char *buf, size_t size, char delim,
+	size_t *length)
+{
+	char *p = buf, *end = buf + size;
+	char tmp[FIX32__SHORTEST_SIZE];
+	size_t n;
+
+	for (n = 0; n < count; n++)
+	{
+		// A separator, the longest string and its terminator.
+		if (end - p > FIX32__SHORTEST_SIZE)
+		{
+			if (n > 0)
+				*p++ = delim;
+			p = fix32__format_shortest(values[n], p);
+			continue;
+		}
+
+		size_t len = (size_t)(fix32__format_shortest(values[n], tmp) - tmp);
+		if ((size_t)(end - p) < (n > 0) + len + 1)
+			break;
+		if (n > 0)
+			*p++ = delim;
+		memcpy(p, tmp, len + 1);
+		p += len;
+	}
+
+	if (p == buf && size > 0)
+		*p = '\0';
+	if (length != NULL)
+		*length = (size_t)(p - buf);
+	return n;
+}
+
+fix32_t fix32_from_str(const char *buf)
+{
+	while (isspace((unsigned char)*buf))
+		buf++;
+
+	/* Decode the sign */
+	bool negative = (*buf == '-');
+	if (*buf == '+' || *buf == '-')
+		buf++;
+
+	/* Decode the integer part, anything above 2^31 is out of range */
+	uint64_t intpart = 0;
+	int count = 0;
+	while (isdigit((unsigned char)*buf))
+	{
+		if (intpart <= 0x80000000)
+			intpart = intpart * 10 + (uint64_t)(*buf - '0');
+		buf++;
+		count++;
+	}
+
+	if (count == 0 || intpart > 0x80000000)
+		return fix32_overflow;
+
+	/* Decode the decimal part */
+	uint64_t fracpart = 0;
+	if (*buf == '.' || *buf == ',')
+	{
+		const char *digits = ++buf;
+		uint64_t f = 0;
+		while (isdigit((unsigned char)*buf))
+		{
+			if (buf - digits < 18)
+				f = f * 10 + (uint64_t)(*buf - '0');
+			buf++;
+		}
+		fracpart = fix32__round_fraction(f, digits, (int)(buf - digits));
+	}
+
+	/* Verify that there is no garbage left over */
+	while (isspace((unsigned char)*buf))
+		buf++;
+	if (*buf != '\0')
+		return fix32_overflow;
+
+	uint64_t mag = (intpart << 32) + fracpart;
+	if (mag > (uint64_t)fix32_maximum + negative)
+		return fix32_overflow;
+
+	return negative ? (fix32_t)(0 - mag) : (fix32_t)mag;
+}
+
+/* Bulk parsing.
+ *
+ * Digits are read 8 at a time where the buffer allows it: a SWAR test
+ * finds how many of the 8 bytes are digits, and three multiplications
+ * combine them into their value, with the missing digits shifted in as
+ * leading zeros. The rounding of the fraction is fix32_from_str's.
+ *
+ * The entries are parsed one after the other, so the time per entry is
+ * mostly the chain of loads that finds where its digits end. Numbers of
+ * the usual length are read with three words whose loads do not depend
+ * on each other's digit counts.
+ */
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define FIX32__SWAR_DIGITS
+#endif
+
+#ifdef FIX32__SWAR_DIGITS
+/* Returns how many of the 8 bytes at p are leading digits and stores their
+ * value to *value.
+ */
+static inline int fix32__swar_digits(const char *p, uint64_t *value)
+{
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+
+	// Per byte, without borrows between bytes: low 7 bits >= '0', low 7
+	// bits <= '9' and the top bit clear.
+	uint64_t ge = (v | 0x8080808080808080) - 0x3030303030303030;
+	uint64_t le = 0xB9B9B9B9B9B9B9B9 - (v & 0x7F7F7F7F7F7F7F7F);
+	uint64_t other = ~(ge & le & ~v) & 0x8080808080808080;
+	int n = other ? __builtin_ctzll(other) / 8 : 8;
+
+	// Without a branch, no digits have to become 0 instead of a shift by 64.
+	v = (v & 0x0F0F0F0F0F0F0F0F & (0 - (uint64_t)(n != 0))) << ((8 * (8 - n)) & 63);
+	v = ((v * 2561) >> 8) & 0x00FF00FF00FF00FF;
+	v = ((v * 6553601) >> 16) & 0x0000FFFF0000FFFF;
+	*value = (v * 42949672960001) >> 32;
+	return n;
+}
+#endif
+
+/* Reads the digits at p, the value of the first 'limit' of them goes to
+ * *value. Returns the end of the digits.
+ */
+static const char *fix32__read_digits(const char *p, const char *end, int limit, uint64_t *value)
+{
+	uint64_t v = 0;
+	int count = 0;
+
+#ifdef FIX32__SWAR_DIGITS
+	while (end - p >= 8)
+	{
+		uint64_t chunk;
+		int n = fix32__swar_digits(p, &chunk);
+		if (count + n <= limit)
+			v = v * _fix32_pow10[n] + chunk;
+		else if (count < limit)
+			v = v * _fix32_pow10[limit - count] + chunk / _fix32_pow10[count + n - limit];
+		count += n;
+		p += n;
+		if (n < 8)
+		{
+			*value = v;
+			return p;
+		}
+	}
+#endif
+
+	while (p < end && *p >= '0' && *p <= '9')
+	{
+		if (count < limit)
+			v = v * 10 + (uint64_t)(*p - '0');
+		count++;
+		p++;
+	}
+
+	*value = v;
+	return p;
+}
+
+#ifdef FIX32__SWAR_DIGITS
+/* The usual shape, up to 7 integer digits and 1 to 15 decimals, read with
+ * three words that do not wait for each other. Returns NULL for anything
+ * else, fix32__parse_number then takes the long way.
+ */
+static inline const char *fix32__parse_short(const char *p, fix32_t *value)
+{
+	bool negative = (*p == '-');
+	p += (*p == '-' || *p == '+');
+
+	uint64_t intpart, word;
+	int n = fix32__swar_digits(p, &intpart);
+	memcpy(&word, p, sizeof(word));
+	if (n == 0 || n == 8 || (char)(word >> (8 * n)) != '.')
+		return NULL;
+
+	const char *digits = p + n + 1;
+	uint64_t f, low;
+	int count = fix32__swar_digits(digits, &f);
+	int more = fix32__swar_digits(digits + 8, &low);
+	if (count == 8)
+	{
+		f = f * _fix32_pow10[more] + low;
+		count += more;
+	}
+	if (count == 0 || count == 16)
+		return NULL;
+
+	uint64_t mag = (intpart << 32) + fix32__round_digits(f, count);
+	*value = negative ? (fix32_t)(0 - mag) : (fix32_t)mag;
+	return digits + count;
+}
+#endif
+
+/* Parses one number, returns its end or NULL if it is malformed or out of
+ * range.
+ */
+static const char *fix32__parse_number(const char *p, const char *end, fix32_t *value)
+{
+#ifdef FIX32__SWAR_DIGITS
+	// A sign, 7 digits, a point and 16 digits are 25 bytes.
+	if (end - p >= 25)
+	{
+		const char *next = fix32__parse_short(p, value);
+		if (next != NULL)
+			return next;
+	}
+#endif
+
+	bool negative = false;
+	if (p < end && (*p == '+' || *p == '-'))
+	{
+		negative = (*p == '-');
+		p++;
+	}
+
+	// Anything above 2^31 is out of range, which takes at most 10 digits
+	// after the leading zeros.
+	const char *start = p;
+	while (p < end && *p == '0')
+		p++;
+	const char *digits = p;
+	uint64_t intpart;
+	p = fix32__read_digits(p, end, 10, &intpart);
+	if (p == start || p - digits > 10 || intpart > 0x80000000)
+		return NULL;
+
+	uint64_t fracpart = 0;
+	if (p < end && *p == '.')
+	{
+		uint64_t f;
+		digits = ++p;
+		p = fix32__read_digits(p, end, 18, &f);
+		fracpart = fix32__round_fraction(f, digits, (int)(p - digits));
+	}
+
+	uint64_t mag = (intpart << 32) + fracpart;
+	if (mag > (uint64_t)fix32_maximum + negative)
+		return NULL;
+
+	*value = negative ? (fix32_t)(0 - mag) : (fix32_t)mag;
+	return p;
+}
+
+static inline const char *fix32__skip_blanks(const char *p, const char *end, char delim)
+{
+	while (p < end && (*p == ' ' || *p == '\t' || *p == '\r') && *p != delim)
+		p++;
+	return p;
+}
+
+size_t fix32_parse_buffer(const char *buf, size_t len, fix32_t *out, size_t cap, char delim,
+	size_t *stopOffset)
+{
+	const char *p = buf, *end = buf + len;
+	size_t n = 0;
+
+	for (;;)
+	{
+		p = fix32__skip_blanks(p, end, delim);
+		if (p == end)
+			break;
+
+		fix32_t value;
+		const char *next = (n < cap) ? fix32__parse_number(p, end, &value) : NULL;
+		if (next != NULL)
+			next = fix32__skip_blanks(next, end, delim);
+		if (next == NULL || (next < end && *next != delim && *next != '\n'))
+			break;
+
+		out[n++] = value;
+		p = (next < end) ? next + 1 : next;
+	}
+
+	if (stopOffset != NULL)
+		*stopOffset = (size_t)(p - buf);
+	return n;
+}
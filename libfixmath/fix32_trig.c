@@ -1,151 +1,495 @@
-#include <limits.h>
-#include "fix32.h"
-
-#define FIXMATH_SIN_LUT
-#if defined(FIXMATH_SIN_LUT)
-#include "fix32_trig_sin_lut.h"
-#endif
-
-
-fix32_t fix32_sin_parabola(fix32_t inAngle)
-{
-	fix32_t abs_inAngle, abs_retval, retval;
-	fix32_t mask;
-
-	/* Absolute function */
-	mask = (inAngle >> (sizeof(fix32_t)*CHAR_BIT-1));
-	abs_inAngle = (inAngle + mask) ^ mask;
-	
-	/* On 0->PI, sin looks like x² that is :
-	   - centered on PI/2,
-	   - equals 1 on PI/2,
-	   - equals 0 on 0 and PI
-	  that means :  4/PI * x  - 4/PI² * x²
-	  Use abs(x) to handle (-PI) -> 0 zone.
-	 */
-	retval = fix32_mul(FOUR_DIV_PI, inAngle) + fix32_mul( fix32_mul(_FOUR_DIV_PI2, inAngle), abs_inAngle );
-	/* At this point, retval equals sin(inAngle) on important points ( -PI, -PI/2, 0, PI/2, PI),
-	   but is not very precise between these points
-	 */
-	#ifndef FIXMATH_FAST_SIN
-	/* Absolute value of retval */
-	mask = (retval >> (sizeof(fix32_t)*CHAR_BIT-1));
-	abs_retval = (retval + mask) ^ mask;
-	/* So improve its precision by adding some x^4 component to retval */
-	retval += fix32_mul(X4_CORRECTION_COMPONENT, fix32_mul(retval, abs_retval) - retval );
-	#endif
-	return retval;
-}
-
-fix32_t fix32_sin(fix32_t inAngle)
-{
-	fix32_t tempAngle = inAngle % (fix32_pi << 1);
-
-	#ifdef FIXMATH_SIN_LUT
-	if(tempAngle < 0)
-		tempAngle += (fix32_pi << 1);
-
-	fix32_t tempOut;
-	if(tempAngle >= fix32_pi) {
-		tempAngle -= fix32_pi;
-		if(tempAngle >= (fix32_pi >> 1))
-			tempAngle = fix32_pi - tempAngle;
-		tempOut = -(tempAngle >= _fix32_sin_lut_count ? fix32_one : _fix32_sin_lut[tempAngle >> 16]);
-	} else {
-		if(tempAngle >= (fix32_pi >> 1))
-			tempAngle = fix32_pi - tempAngle;
-		tempOut = (tempAngle >= _fix32_sin_lut_count ? fix32_one : _fix32_sin_lut[tempAngle >> 16]);
-	}
-	#else
-	if(tempAngle > fix32_pi)
-		tempAngle -= (fix32_pi << 1);
-	else if(tempAngle < -fix32_pi)
-		tempAngle += (fix32_pi << 1);
-
-	fix32_t tempAngleSq = fix32_mul(tempAngle, tempAngle);
-
-
-	fix32_t tempOut = tempAngle;
-	tempAngle = fix32_mul(tempAngle, tempAngleSq);
-	tempOut -= (tempAngle / 6);
-	tempAngle = fix32_mul(tempAngle, tempAngleSq);
-	tempOut += (tempAngle / 120);
-	tempAngle = fix32_mul(tempAngle, tempAngleSq);
-	tempOut -= (tempAngle / 5040);
-	tempAngle = fix32_mul(tempAngle, tempAngleSq);
-	tempOut += (tempAngle / 362880);
-	tempAngle = fix32_mul(tempAngle, tempAngleSq);
-	tempOut -= (tempAngle / 39916800);
-	tempAngle = fix32_mul(tempAngle, tempAngleSq);
-	tempOut -= (tempAngle / 6227020800);
-	
-
-	#endif
-
-	return tempOut;
-}
-
-fix32_t fix32_cos(fix32_t inAngle)
-{
-	return fix32_sin(inAngle + (fix32_pi >> 1));
-}
-
-fix32_t fix32_tan(fix32_t inAngle)
-{
-	#ifndef FIXMATH_NO_OVERFLOW
-	return fix32_sdiv(fix32_sin(inAngle), fix32_cos(inAngle));
-	#elif
-	return fix32_div(fix32_sin(inAngle), fix32_cos(inAngle));
-	#endif
-}
-
-fix32_t fix32_asin(fix32_t x)
-{
-	if((x > fix32_one)
-		|| (x < -fix32_one))
-		return 0;
-
-	fix32_t out;
-	out = (fix32_one - fix32_mul(x, x));
-	out = fix32_div(x, fix32_sqrt(out));
-	out = fix32_atan(out);
-	return out;
-}
-
-fix32_t fix32_acos(fix32_t x)
-{
-	return ((fix32_pi >> 1) - fix32_asin(x));
-}
-
-fix32_t fix32_atan2(fix32_t inY , fix32_t inX)
-{
-	fix32_t abs_inY, mask, angle, r, r_3;
-
-	/* Absolute inY */
-	mask = (inY >> (sizeof(fix32_t)*CHAR_BIT-1));
-	abs_inY = (inY + mask) ^ mask;
-
-	if (inX >= 0)
-	{
-		r = fix32_div( (inX - abs_inY), (inX + abs_inY));
-		r_3 = fix32_mul(fix32_mul(r, r),r);
-		angle = fix32_mul(0x0000000031238038 , r_3) - fix32_mul(0x00000000F8EED205,r) + PI_DIV_4;
-	} else {
-		r = fix32_div( (inX + abs_inY), (abs_inY - inX));
-		r_3 = fix32_mul(fix32_mul(r, r),r);
-		angle = fix32_mul(0x0000000031238038 , r_3)
-			- fix32_mul(0x00000000F8EED205,r)
-			+ THREE_PI_DIV_4;
-	}
-	if (inY < 0)
-	{
-		angle = -angle;
-	}
-
-	return angle;
-}
-
-fix32_t fix32_atan(fix32_t x)
-{
-	return fix32_atan2(x, fix32_one);
-}
+#include <limits.h>
+#include "fix32.h"
+#include "fix32_internal.h"
+
+/* Constants for the internal high precision formats. */
+static const int64_t FIX32_ONE_Q62       = 0x4000000000000000; /*!< 1 in Q62 */
+static const int64_t FIX32_PI_DIV_8_Q62  = 0x1921FB54442D1847; /*!< pi/8 in Q62 */
+static const int64_t FIX32_PI_DIV_2_Q62  = 0x6487ED5110B4611A; /*!< pi/2 in Q62 */
+static const int64_t FIX32_TWO_PI_Q60    = 0x6487ED5110B4611A; /*!< 2*pi in Q60 */
+static const int64_t FIX32_SQRT_HALF_Q62 = 0x2D413CCCFE779921; /*!< sqrt(1/2) in Q62 */
+
+static inline fix32_t fix32__from_q62(int64_t x)
+{
+	return (x + ((int64_t)1 << 29)) >> 30;
+}
+
+#if defined(FIXMATH_SIN_LUT)
+#include "fix32_trig_sin_lut.h"
+#endif
+
+
+fix32_t fix32_sin_parabola(fix32_t inAngle)
+{
+	fix32_t abs_inAngle, abs_retval, retval;
+	fix32_t mask;
+
+	/* Absolute function */
+	mask = (inAngle >> (sizeof(fix32_t)*CHAR_BIT-1));
+	abs_inAngle = (inAngle + mask) ^ mask;
+	
+	/* On 0->PI, sin looks like x² that is :
+	   - centered on PI/2,
+	   - equals 1 on PI/2,
+	   - equals 0 on 0 and PI
+	  that means :  4/PI * x  - 4/PI² * x²
+	  Use abs(x) to handle (-PI) -> 0 zone.
+	 */
+	retval = fix32_mul(FOUR_DIV_PI, inAngle) + fix32_mul( fix32_mul(_FOUR_DIV_PI2, inAngle), abs_inAngle );
+	/* At this point, retval equals sin(inAngle) on important points ( -PI, -PI/2, 0, PI/2, PI),
+	   but is not very precise between these points
+	 */
+	#ifndef FIXMATH_FAST_SIN
+	/* Absolute value of retval */
+	mask = (retval >> (sizeof(fix32_t)*CHAR_BIT-1));
+	abs_retval = (retval + mask) ^ mask;
+	/* So improve its precision by adding some x^4 component to retval */
+	retval += fix32_mul(X4_CORRECTION_COMPONENT, fix32_mul(retval, abs_retval) - retval );
+	#endif
+	return retval;
+}
+
+fix32_t fix32_sin(fix32_t inAngle)
+{
+	#ifdef FIXMATH_SIN_LUT
+	fix32_t tempAngle = inAngle % (fix32_pi << 1);
+	if(tempAngle < 0)
+		tempAngle += (fix32_pi << 1);
+
+	fix32_t tempOut;
+	if(tempAngle >= fix32_pi) {
+		tempAngle -= fix32_pi;
+		if(tempAngle >= (fix32_pi >> 1))
+			tempAngle = fix32_pi - tempAngle;
+		tempOut = -((tempAngle >> 16) >= _fix32_sin_lut_count ? fix32_one : _fix32_sin_lut[tempAngle >> 16]);
+	} else {
+		if(tempAngle >= (fix32_pi >> 1))
+			tempAngle = fix32_pi - tempAngle;
+		tempOut = ((tempAngle >> 16) >= _fix32_sin_lut_count ? fix32_one : _fix32_sin_lut[tempAngle >> 16]);
+	}
+	return tempOut;
+	#else
+	return fix32_sin_turns64(fix32_rad_to_turns64(inAngle));
+	#endif
+}
+
+fix32_t fix32_cos(fix32_t inAngle)
+{
+	#ifdef FIXMATH_SIN_LUT
+	return fix32_sin(inAngle + (fix32_pi >> 1));
+	#else
+	return fix32_cos_turns64(fix32_rad_to_turns64(inAngle));
+	#endif
+}
+
+/* Reduced precision sine and cosine, see fix32.h for the tiers.
+ *
+ * The angle is reduced exactly to a binary angle and folded to
+ * z = [-1, 1] quarter turns, then sin(z * pi/2) is an odd polynomial in z,
+ * evaluated in Q30 with plain 64 bit multiplies. The coefficients are
+ * minimax for z^2 = [0, 1], lowest order first.
+ */
+static const int64_t _fix32_sin_fast_poly[4] = {
+	0x6487E84A, -0x2956D8D6, 0x05168732, -0x00479B91
+	};
+static const int64_t _fix32_sin_mid_poly[5] = {
+	0x6487ED4A, -0x29577861, 0x0519A3BE, -0x004C94C8, 0x00027C28
+	};
+
+static fix32_t fix32__sin_tier(uint64_t inTurns, const int64_t *poly, int count)
+{
+	// Angles beyond a quarter turn are mirrored around it, 1/2 - t.
+	int64_t t = (int64_t)inTurns;
+	if (t > ((int64_t)1 << 62) || t < -((int64_t)1 << 62))
+		t = (int64_t)(((uint64_t)1 << 63) - inTurns);
+
+	int64_t z = t >> 32;
+	int64_t z2 = (z * z) >> 30;
+	int64_t p = poly[count - 1];
+	int i;
+	for (i = count - 2; i >= 0; i--)
+		p = poly[i] + ((p * z2) >> 30);
+
+	return (p * z + ((int64_t)1 << 27)) >> 28;
+}
+
+fix32_t fix32_sin_fast(fix32_t inAngle)
+{
+	return fix32__sin_tier(fix32_rad_to_turns64(inAngle), _fix32_sin_fast_poly, 4);
+}
+
+fix32_t fix32_sin_mid(fix32_t inAngle)
+{
+	return fix32__sin_tier(fix32_rad_to_turns64(inAngle), _fix32_sin_mid_poly, 5);
+}
+
+fix32_t fix32_cos_fast(fix32_t inAngle)
+{
+	return fix32__sin_tier(fix32_rad_to_turns64(inAngle) + ((uint64_t)1 << 62), _fix32_sin_fast_poly, 4);
+}
+
+fix32_t fix32_cos_mid(fix32_t inAngle)
+{
+	return fix32__sin_tier(fix32_rad_to_turns64(inAngle) + ((uint64_t)1 << 62), _fix32_sin_mid_poly, 5);
+}
+
+/* Odd minimax polynomial for asin(x) on [0, 0.5], Q62, lowest order
+ * first. The error is below 5e-12.
+ */
+static const int64_t _fix32_asin_poly[8] = {
+	0x3FFFFFFFDA336601, 0x0AAAAAC640B280A2, 0x04CCC6F0C585906F, 0x02DBFC164CD3922B,
+	0x01EAACBDAACF76EE, 0x01A12B4C160BF7F6, 0x0055A97DBC3B5C02, 0x025F6EC5372FED53
+	};
+
+/* Returns asin(x) in Q62 for x = [-0.5, 0.5] in Q62. */
+static int64_t fix32__asin_poly(int64_t x)
+{
+	int64_t x2 = fix32__mul_shr(x, x, 62);
+	int64_t result = _fix32_asin_poly[7];
+	int i;
+	for (i = 6; i >= 0; i--)
+		result = _fix32_asin_poly[i] + fix32__mul_shr(result, x2, 62);
+
+	return fix32__mul_shr(result, x, 62);
+}
+
+/* Returns acos(x) = 2 * asin(sqrt((1 - x) / 2)) in Q62 for x = [0.5, 1].
+ * The halving is done after the square root, so that no input bits are
+ * lost before it.
+ */
+static int64_t fix32__acos_tail(fix32_t x)
+{
+	int64_t root = fix32_sqrt(fix32_one - x);
+	int64_t z = fix32__mul_shr(root * ((int64_t)1 << 30), FIX32_SQRT_HALF_Q62, 62);
+	return fix32__asin_poly(z) * 2;
+}
+
+fix32_t fix32_asin(fix32_t x)
+{
+	if((x > fix32_one)
+		|| (x < -fix32_one))
+		return 0;
+
+	fix32_t abs_x = fix32_abs(x);
+	int64_t result;
+	if (abs_x <= (fix32_one >> 1))
+		result = fix32__asin_poly(abs_x * ((int64_t)1 << 30));
+	else
+		result = FIX32_PI_DIV_2_Q62 - fix32__acos_tail(abs_x);
+
+	result = fix32__from_q62(result);
+	return (x < 0 ? -result : result);
+}
+
+fix32_t fix32_acos(fix32_t x)
+{
+	if((x > fix32_one)
+		|| (x < -fix32_one))
+		return (fix32_pi >> 1);
+
+	// Assembled in Q61 as the result goes up to pi.
+	int64_t result;
+	if (fix32_abs(x) <= (fix32_one >> 1))
+		result = (FIX32_PI_DIV_2_Q62 >> 1) - (fix32__asin_poly(x * ((int64_t)1 << 30)) >> 1);
+	else if (x > 0)
+		result = fix32__acos_tail(x) >> 1;
+	else
+		result = FIX32_PI_DIV_2_Q62 - (fix32__acos_tail(-x) >> 1);
+
+	return (result + ((int64_t)1 << 28)) >> 29;
+}
+
+/* All arctangent tiers share the same front end: the vector is mirrored
+ * into the first octant, where t = min(|x|, |y|) / max(|x|, |y|) is in
+ * [0, 1], and the octant kernel of the tier gives atan(t) as a fraction of
+ * pi/4. The result is then mirrored back as a binary angle, where adding
+ * quarter and half turns is exact.
+ *
+ * Maximum errors over the full input range:
+ *   fast     8 x cubic table       3.7e-7 rad
+ *   mid      8 x 4th order table   1.2e-8 rad
+ *   precise  8 x 6th order table   1 LSB (2.3e-10 rad)
+ */
+enum {
+	FIX32__ATAN_FAST,
+	FIX32__ATAN_MID,
+	FIX32__ATAN_PRECISE
+};
+
+/* Returns num / den in Q62, for 0 <= num <= den and den > 0. */
+static uint64_t fix32__ratio_q62(uint64_t num, uint64_t den)
+{
+	int shift = clz(den);
+	return fix32__umul_shr(num << shift, fix32__recip_norm(den << shift), 64);
+}
+
+/* Piecewise polynomial for atan(t) * 4/pi on t = [0, 1], in eight segments
+ * of 1/8 each. Coefficients are in Q62, lowest order first, for the offset
+ * from the centre of the segment. The error is below 1e-11.
+ */
+static const int64_t _fix32_atan_poly[8][7] = {
+	{ 0x05161A861CB135DA, 0x512B961FE4383F30, -0x050DABB5D475FC7B, -0x1A8827D055B1CD9D, 0x04FE97A74F5B82A2, 0x0F49F342DEF39989, -0x04E0B977715515A6 },
+	{ 0x0F1A7F9D085CE5D9, 0x4EB84735F0CE7887, -0x0E4239552E575C8F, -0x15E7B6C8B06F52C4, 0x0CD6B473D17D6548, 0x08F4F36DE447E247, -0x0AEB04380DC6F270 },
+	{ 0x18AE6855098EEC32, 0x4A3CD147ACF045D0, -0x15229FCAE2118026, -0x0E857E0CA015C8F0, 0x0FD42523603D1923, 0x00C1D9FAC4F27992, -0x09ED61B52C6BA544 },
+	{ 0x219B31A2527DC885, 0x44655B409558DFCD, -0x191DAA524F7EC637, -0x06D6BCA1511054D1, 0x0E4EAECEA2301D96, -0x04EBA6F0416FEACF, -0x04F9697AFF856D37 },
+	{ 0x29C0D4F5478FBBDC, 0x3DE6BF373FD46E3B, -0x1A734F6D8FEEA8A4, -0x009ACDB42B1F97D3, 0x0A6F1D3E09D98DF1, -0x06D49B237B49B15D, -0x006B43ACD5CFED0C },
+	{ 0x31142B777950C7C7, 0x375564FC2FCEFB0B, -0x19D505B91E7F3330, 0x038E0288CB82D3D0, 0x0648069A4707B2CF, -0x06215C817A186AED, 0x01EB5217B1B94FFB },
+	{ 0x3799A3BFBA04E47E, 0x311589C472300695, -0x1805B8E25D97710A, 0x05D2085BBD4ED534, 0x02F64BC93A2EAE29, -0x046C83F9AB8CBDB2, 0x02695F1733DE150D },
+	{ 0x3D5F4E3DD7E474F6, 0x2B5E9B4200D1DA1A, -0x15A3C316E1757A3C, 0x06B3CE4426E61C9E, 0x00BE05ACA91366EA, -0x02BCCD618ACF9FE0, 0x020202EBE511EB64 },
+	};
+
+/* Returns atan(t) as a fraction of an octant (pi/4) in Q62, t = [0, 1] in Q62,
+ * from one of the piecewise polynomials with count coefficients per segment.
+ */
+static int64_t fix32__atan_octant(uint64_t t, const int64_t *poly, int count)
+{
+	unsigned k = (t >> 59);
+	if (k > 7)
+		k = 7;
+
+	int64_t s = (int64_t)t - ((int64_t)(2 * k + 1) << 58);
+	const int64_t *c = poly + k * count;
+	int64_t result = c[count - 1];
+	int i;
+	for (i = count - 2; i >= 0; i--)
+		result = c[i] + fix32__mul_shr(result, s, 62);
+
+	return (result < 0 ? 0 : result);
+}
+
+/* The same segments with lower degrees for the reduced precision tiers.
+ * The errors are below 3.7e-7 and 1.2e-8 rad.
+ */
+static const int64_t _fix32_atan_fast_poly[8][4] = {
+	{ 0x051619E6E5D3788D, 0x512B9436CF398BE4, -0x0508B162E2717634, -0x1A78DDDD30B39400 },
+	{ 0x0F1A7E038F2EEF66, 0x4EB846175D897E89, -0x0E356C2E8147A6AA, -0x15DEC1D53FA5E549 },
+	{ 0x18AE665BC296B683, 0x4A3CD12F604A8C71, -0x1512D45586A30DBD, -0x0E84BC328FB78959 },
+	{ 0x219B2FD91BD12505, 0x44655BDDF1E5BFD2, -0x190F5FFDBA1A257D, -0x06DBA848337A42B2 },
+	{ 0x29C0D3A77150712D, 0x3DE6C011C32C3599, -0x1A68E0AE22187726, -0x00A1A24F4D7D9CFF },
+	{ 0x31142AAE3B133C17, 0x375565C0559F35CF, -0x19CEBC0493C993B1, 0x0387E12C45F1408F },
+	{ 0x3799A360A35FDA27, 0x31158A520329CBF8, -0x1802C07A5D350973, 0x05CD9BD7BFFB5002 },
+	{ 0x3D5F4E25D6EE822D, 0x2B5E9B999D32D484, -0x15A3034F7164DA1F, 0x06B11176C37CB7E9 },
+	};
+static const int64_t _fix32_atan_mid_poly[8][5] = {
+	{ 0x05161A861CB135DA, 0x512B91584C1BBE45, -0x050DAA2F61595C2D, -0x1A750ABAD73FD80F, 0x04F87E734BCF9579 },
+	{ 0x0F1A7F9D085CE5D9, 0x4EB84469433E3867, -0x0E4235EB53A5E842, -0x15DC846BBE3AC802, 0x0CC90E2214374DFA },
+	{ 0x18AE6855098EEC32, 0x4A3CD10B4CEA0692, -0x15229CB07C2AEAF3, -0x0E848C0194EBADE1, 0x0FC7BC1F6BF2240F },
+	{ 0x219B31A2527DC885, 0x44655CCA82661ED7, -0x191DA8C467C61CDA, -0x06DCE39326533F73, 0x0E4877171713FEF3 },
+	{ 0x29C0D4F5478FBBDC, 0x3DE6C159E0741997, -0x1A734F4C2BE094BD, -0x00A357B647E0A0BE, 0x0A6E97558F335FB2 },
+	{ 0x31142B777950C7C7, 0x375566E6ADFC6CDC, -0x19D50652C1F65919, 0x038658BE21A870C1, 0x064A6CE34E8F82AD },
+	{ 0x3799A3BFBA04E47E, 0x31158B265A02EE7F, -0x1805B9A3572826B7, 0x05CC80B8A8280E03, 0x02F94F8FE43C4EB6 },
+	{ 0x3D5F4E3DD7E474F6, 0x2B5E9C1CF8E4506F, -0x15A3C3B784E85060, 0x06B0624E3C5FC4F6, 0x00C08833B1E03CFF },
+	};
+
+/* Returns |atan2(inY, inX)| as a binary angle in [0, 2^63]. */
+static inline uint64_t fix32__atan2_abs(fix32_t inY, fix32_t inX, int tier)
+{
+	uint64_t abs_x = (inX < 0 ? -(uint64_t)inX : (uint64_t)inX);
+	uint64_t abs_y = (inY < 0 ? -(uint64_t)inY : (uint64_t)inY);
+	int swap = (abs_y > abs_x);
+	uint64_t t, angle;
+
+	if (abs_x == 0 && abs_y == 0)
+		return 0;
+
+	t = (swap ? fix32__ratio_q62(abs_x, abs_y) : fix32__ratio_q62(abs_y, abs_x));
+
+	switch (tier)
+	{
+		case FIX32__ATAN_FAST: angle = fix32__atan_octant(t, _fix32_atan_fast_poly[0], 4); break;
+		case FIX32__ATAN_MID:  angle = fix32__atan_octant(t, _fix32_atan_mid_poly[0], 5); break;
+		default:               angle = fix32__atan_octant(t, _fix32_atan_poly[0], 7); break;
+	}
+
+	// An octant is 2^61 in binary angle units, hence the shift.
+	angle >>= 1;
+	if (swap)
+		angle = ((uint64_t)1 << 62) - angle;
+	if (inX < 0)
+		angle = ((uint64_t)1 << 63) - angle;
+
+	return angle;
+}
+
+static inline fix32_t fix32__atan2_rad(fix32_t inY, fix32_t inX, int tier)
+{
+	uint64_t angle = fix32__atan2_abs(inY, inX, tier);
+	fix32_t result = (fix32__umul_shr(angle, FIX32_TWO_PI_Q60, 91) + 1) >> 1;
+	return (inY < 0 ? -result : result);
+}
+
+fix32_t fix32_atan2(fix32_t inY, fix32_t inX)
+{
+	return fix32__atan2_rad(inY, inX, FIX32__ATAN_PRECISE);
+}
+
+fix32_t fix32_atan2_mid(fix32_t inY, fix32_t inX)
+{
+	return fix32__atan2_rad(inY, inX, FIX32__ATAN_MID);
+}
+
+fix32_t fix32_atan2_fast(fix32_t inY, fix32_t inX)
+{
+	return fix32__atan2_rad(inY, inX, FIX32__ATAN_FAST);
+}
+
+fix32_t fix32_atan(fix32_t x)
+{
+	return fix32_atan2(x, fix32_one);
+}
+
+
+
+/* Binary angle (turns) trigonometry.
+ *
+ * The angle is an unsigned fraction of a full turn, 2^64 being one full
+ * revolution. The top two bits give the quadrant and the following six bits
+ * the nearest entry of a 65 entry quarter-wave table, so no division or
+ * modulo is needed for the range reduction and wraparound is free.
+ *
+ * The remaining offset (at most pi/256 radians) is handled with
+ * sin(a + d) = sin(a)cos(d) + cos(a)sin(d), where sin(d) and cos(d) are
+ * short Taylor series. Everything is computed in Q62, so the result is
+ * within 1 LSB of the exact value.
+ */
+static const int64_t _fix32_sin_turns_table[65] = {
+	0x0000000000000000, 0x0192155F7A3667E0, 0x0323ECBE21BB027D, 0x04B54824B3867D73,
+	0x0645E9AF0A6D0AF8, 0x07D59395AA5CC38D, 0x0964083747309D11, 0x0AF10A22459FE32A,
+	0x0C7C5C1E34D3055B, 0x0E05C1353F27B17E, 0x0F8CFCBD90AF8D58, 0x1111D262B1F67761,
+	0x1294062ED59F05A9, 0x14135C9417660143, 0x158F9A75AB1FDCFE, 0x17088530FA459EAF,
+	0x187DE2A6AEA962D2, 0x19EF7943A8ED8A2E, 0x1B5D1009E15CC02B, 0x1CC66E9931C45E17,
+	0x1E2B5D3806F63B1E, 0x1F8BA4DBF89AB9FB, 0x20E70F3245FFDB2D, 0x223D66A836964508,
+	0x238E76735CD190D9, 0x24DA0A99BA25BD51, 0x261FEFF9C2E069C2, 0x275FF45240A17279,
+	0x2899E64A123BAC30, 0x29CD9577C7CBD228, 0x2AFAD26919D93F45, 0x2C216EAA3A59BDB7,
+	0x2D413CCCFE779921, 0x2E5A106FDFFF2C87, 0x2F6BBE44D55F5DBC, 0x30761C17FF2EDBA4,
+	0x317900D62A2E816A, 0x3274449324C7F69F, 0x3367C08FE70E8168, 0x34534F408C4F03BB,
+	0x3536CC521D434606, 0x361214B02A03FF37, 0x36E5068A32DC7B22, 0x37AF8158DF2A533F,
+	0x387165E3017B61A4, 0x392A96426823E9ED, 0x39DAF5E8798EE5E2, 0x3A8269A29B927359,
+	0x3B20D79E651A8C51, 0x3BB6276D998478C2, 0x3C424209ED0DC97F, 0x3CC511D891C223DD,
+	0x3D3E82AD8C5BB4BB, 0x3DAE81CED092C67A, 0x3E14FDF72461AE55, 0x3E71E758C9CB118A,
+	0x3EC52F9FEEB96056, 0x3F0EC9F4E297526B, 0x3F4EAAFE114A2D43, 0x3F84C8E1C33FA68F,
+	0x3FB11B47A24A4B3C, 0x3FD39B5A0310742A, 0x3FEC43C6F2DAFBC7, 0x3FFB10C1099A1976,
+	0x4000000000000000
+	}; /*!< sin(j * pi / 128) for j = 0..64, in Q62 */
+
+/* Computes sin and cos of the binary angle in Q62. */
+static void fix32__sincos_turns_q62(uint64_t inTurns, int64_t *outSin, int64_t *outCos)
+{
+	uint64_t x = inTurns << 2;               // Position within the quadrant
+	unsigned j = ((x >> 57) + 1) >> 1;       // Nearest table entry, 0..64
+	int64_t  d = (int64_t)(x - ((uint64_t)j << 58));
+
+	// The offset from the table entry in radians, |delta| <= pi/256.
+	int64_t delta  = fix32__mul_shr(d, FIX32_PI_DIV_8_Q62, 62);
+	int64_t delta2 = fix32__mul_shr(delta, delta, 62);
+
+	// sin(d) = d * (1 - d^2/6 * (1 - d^2/20))
+	// cos(d) = 1 - d^2/2 * (1 - d^2/12)
+	int64_t sin_d = delta - fix32__mul_shr(delta,
+		fix32__mul_shr(delta2 / 6, FIX32_ONE_Q62 - delta2 / 20, 62), 62);
+	int64_t cos_d = FIX32_ONE_Q62 - fix32__mul_shr(delta2 >> 1, FIX32_ONE_Q62 - delta2 / 12, 62);
+
+	int64_t sin_a = _fix32_sin_turns_table[j];
+	int64_t cos_a = _fix32_sin_turns_table[64 - j];
+	int64_t s = fix32__mul_shr(sin_a, cos_d, 62) + fix32__mul_shr(cos_a, sin_d, 62);
+	int64_t c = fix32__mul_shr(cos_a, cos_d, 62) - fix32__mul_shr(sin_a, sin_d, 62);
+
+	switch (inTurns >> 62)
+	{
+		case 0: *outSin =  s; *outCos =  c; break;
+		case 1: *outSin =  c; *outCos = -s; break;
+		case 2: *outSin = -s; *outCos = -c; break;
+		default: *outSin = -c; *outCos =  s; break;
+	}
+}
+
+fix32_t fix32_sin_turns64(uint64_t inTurns)
+{
+	int64_t s, c;
+	fix32__sincos_turns_q62(inTurns, &s, &c);
+	return fix32__from_q62(s);
+}
+
+fix32_t fix32_cos_turns64(uint64_t inTurns)
+{
+	int64_t s, c;
+	fix32__sincos_turns_q62(inTurns, &s, &c);
+	return fix32__from_q62(c);
+}
+
+void fix32_sincos_turns64(uint64_t inTurns, fix32_t *outSin, fix32_t *outCos)
+{
+	int64_t s, c;
+	fix32__sincos_turns_q62(inTurns, &s, &c);
+	*outSin = fix32__from_q62(s);
+	*outCos = fix32__from_q62(c);
+}
+
+uint64_t fix32_atan2_turns64(fix32_t inY, fix32_t inX)
+{
+	uint64_t angle = fix32__atan2_abs(inY, inX, FIX32__ATAN_PRECISE);
+	return (inY < 0 ? -angle : angle);
+}
+
+/* Conversions between binary angles, radians and degrees. The binary angle
+ * is treated as signed, so the results are in [-pi, pi) and [-180, 180).
+ */
+static const int64_t FIX32_TURNS_PER_DEG_Q39 = 0x5B05B05B05B05B06; /*!< 2^32/360 in Q39 */
+
+fix32_t fix32_turns64_to_rad(uint64_t inTurns)
+{
+	return (fix32__mul_shr((int64_t)inTurns, FIX32_TWO_PI_Q60, 91) + 1) >> 1;
+}
+
+uint64_t fix32_rad_to_turns64(fix32_t inAngle)
+{
+	return (uint64_t)fix32__mul_shr(inAngle, FIX32_TURNS_PER_RAD_Q31, 31);
+}
+
+fix32_t fix32_turns64_to_deg(uint64_t inTurns)
+{
+	return (fix32__mul_shr((int64_t)inTurns, 360, 31) + 1) >> 1;
+}
+
+uint64_t fix32_deg_to_turns64(fix32_t inAngle)
+{
+	return (uint64_t)fix32__mul_shr(inAngle, FIX32_TURNS_PER_DEG_Q39, 39);
+}
+
+/* The tangent shares the binary angle reduction and the quarter-wave table
+ * with the functions above. The angle is folded to [0, pi/4] with one
+ * reduction, and sin and cos of the folded angle come from a single table
+ * evaluation. In the first octant tan = sin / cos, which is at most 1;
+ * in the complementary octant tan(pi/2 - a) = 1 / tan(a) = cos / sin, which
+ * saturates to fix32_maximum near the poles, like fix32_sdiv.
+ */
+fix32_t fix32_tan(fix32_t inAngle)
+{
+	// The period of the tangent is half a turn, 2^63.
+	int64_t  a = (int64_t)(fix32_rad_to_turns64(inAngle) << 1) >> 1;
+	uint64_t abs_a = (a < 0 ? -(uint64_t)a : (uint64_t)a);
+	int complement = (abs_a > ((uint64_t)1 << 61));
+	int64_t s, c;
+	fix32_t result;
+
+	if (complement)
+		abs_a = ((uint64_t)1 << 62) - abs_a;
+	fix32__sincos_turns_q62(abs_a, &s, &c);
+
+	if (!complement)
+	{
+		result = fix32__from_q62(fix32__ratio_q62(s, c));
+	}
+	else
+	{
+		if (s <= (c >> 31))
+			return (a >= 0 ? fix32_maximum : fix32_minimum);
+
+		// cos / sin in Q32, rounded. Here s > 2^30, so the shift is at least 60.
+		int shift = clz(s);
+		uint64_t recip = fix32__recip_norm((uint64_t)s << shift);
+		result = (fix32__umul_shr(c, recip, 93 - shift) + 1) >> 1;
+	}
+
+	return (a < 0 ? -result : result);
+}
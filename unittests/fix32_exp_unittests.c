@@ -1,126 +1,553 @@
-//#include "../libfixmath/fix32.h"
-//#include <stdio.h>
-//#include <math.h>
-//#include <stdbool.h>
-//#include "unittests.h"
-//
-//#define delta(a,b) (((a)>=(b)) ? (a)-(b) : (b)-(a))
-//
-//int main()
-//{
-//    int status = 0;
-//    {
-//        COMMENT("Testing fix32_exp() corner cases");
-//        TEST(fix32_exp(0) == fix32_one);
-//        TEST(fix32_exp(fix32_minimum) == 0);
-//        TEST(fix32_exp(fix32_maximum) == fix32_maximum);
-//    }
-//    
-//    {
-//        COMMENT("Testing fix32_exp() accuracy over -4..4");
-//        
-//        fix32_t max_delta = -1;
-//        fix32_t worst = 0;
-//        fix32_t sum = 0;
-//        int count = 0;
-//        fix32_t a;
-//        
-//        // the original implementation took forever to run this, so I made the 
-//        // range a little shorter
-//        for (a = fix32_from_dbl(-0.4); a < fix32_from_dbl(0.4); a += 63)
-//        {
-//            fix32_t result = fix32_exp(a);
-//            fix32_t resultf = fix32_from_dbl(exp(fix32_to_dbl(a)));
-//            
-//            fix32_t d = delta(result, resultf);
-//            if (d > max_delta)
-//            {
-//                max_delta = d;
-//                worst = a;
-//            }
-//            
-//            sum += d;
-//            count++;
-//        }
-//        
-//        printf("Worst delta %ld with input %ld\n", max_delta, worst);
-//        printf("Average delta %0.2f\n", (float)sum / count);
-//        
-//        TEST(max_delta < 200);
-//    }
-//    
-//    {
-//        COMMENT("Testing fix32_exp() accuracy over full range");
-//        
-//        float max_delta = -1;
-//        fix32_t worst = 0;
-//        float sum = 0;
-//        int count = 0;
-//        fix32_t a;
-//        
-//        // Test the whole range of results 0..32768 with a bit less samples
-//        for (a = -772243; a < 681391; a += 113)
-//        {
-//            fix32_t result = fix32_exp(a);
-//            fix32_t resultf = fix32_from_dbl(exp(fix32_to_dbl(a)));
-//            
-//            fix32_t d1 = delta(result, resultf);
-//            
-//            if (d1 > 0) d1--; // Forgive +-1 for the fix32_t inaccuracy
-//            
-//            float d = (float)d1 / resultf * 100;
-//            
-//            if (resultf < 1000) continue; // Percentages can explode when result is almost 0.
-//            
-//            if (d > max_delta)
-//            {
-//                max_delta = d;
-//                worst = a;
-//            }
-//            
-//            sum += d;
-//            count++;
-//        }
-//        
-//        printf("Worst delta %0.4f%% with input %ld\n", max_delta, worst);
-//        printf("Average delta %0.4f%%\n", sum / count);
-//        
-//        TEST(max_delta < 1);
-//    }
-//    
-//    {
-//        COMMENT("Testing fix32_log() accuracy over full range");
-//        
-//        fix32_t max_delta = -1;
-//        fix32_t worst = 0;
-//        fix32_t sum = 0;
-//        int count = 0;
-//        fix32_t a;
-//        
-//        for (a = 100; a > 0 && a < fix32_maximum - 7561; a += 7561)
-//        {
-//            fix32_t result = fix32_log(a);
-//            fix32_t resultf = fix32_from_dbl(log(fix32_to_dbl(a)));
-//            
-//            fix32_t d = delta(result, resultf);
-//            if (d > max_delta)
-//            {
-//                max_delta = d;
-//                worst = a;
-//            }
-//            
-//            sum += d;
-//            count++;
-//        }
-//        
-//        printf("Worst delta %ld with input %ld\n", max_delta, worst);
-//        printf("Average delta %0.2f\n", (float)sum / count);
-//        
-//        TEST(max_delta < 20);
-//    }
-//    
-//    if (status != 0)
-//    fprintf(stdout, "\n\nSome tests FAILED!\n");
-//
-//    return status;
-//}
+#include "../libfixmath/fix32.h"
+#include <stdio.h>
+#include <math.h>
+#include <stdbool.h>
+#include "unittests.h"
+
+#define delta(a,b) (((a)>=(b)) ? (a)-(b) : (b)-(a))
+
+int main()
+{
+    int status = 0;
+    {
+        COMMENT("Testing fix32_exp() corner cases");
+        TEST(fix32_exp(0) == fix32_one);
+        TEST(fix32_exp(fix32_one) == fix32_e);
+        TEST(fix32_exp(fix32_minimum) == 0);
+        TEST(fix32_exp(fix32_maximum) == fix32_maximum);
+        // Saturation bounds, ln(2^31) and ln(2^-33)
+        TEST(fix32_exp(92288378626LL) == fix32_maximum);
+        TEST(fix32_exp(92288378625LL) > fix32_maximum - 4294967296LL);
+        TEST(fix32_exp(-98242467570LL) == 0);
+        TEST(fix32_exp(-98242467569LL) == 1);
+    }
+
+    {
+        COMMENT("Testing fix32_exp() accuracy over -4..4");
+
+        fix32_t max_delta = -1;
+        fix32_t worst = 0;
+        double sum = 0;
+        int count = 0;
+        fix32_t a;
+
+        for (a = fix32_from_int(-4); a < fix32_from_int(4); a += 6361)
+        {
+            fix32_t result = fix32_exp(a);
+            fix32_t resultf = (fix32_t)llroundl(expl((long double)a / 4294967296.0L) * 4294967296.0L);
+
+            fix32_t d = delta(result, resultf);
+            if (d > max_delta)
+            {
+                max_delta = d;
+                worst = a;
+            }
+
+            sum += d;
+            count++;
+        }
+
+        printf("Worst delta %lld with input %lld\n", (long long)max_delta, (long long)worst);
+        printf("Average delta %0.2f\n", sum / count);
+
+        TEST(max_delta <= 1);
+    }
+
+    {
+        COMMENT("Testing fix32_exp() accuracy for large results");
+
+        double max_delta = -1;
+        fix32_t worst = 0;
+        fix32_t a;
+
+        // Relative error, in units of 2^-63, i.e. the LSB of the largest results.
+        for (a = -98242467570LL; a < 92288378626LL; a += 1000003)
+        {
+            long double resultf = expl((long double)a / 4294967296.0L) * 4294967296.0L;
+            long double d = fabsl((long double)fix32_exp(a) - resultf);
+
+            // Below 2^29 the rounding to 1 LSB dominates the relative error.
+            if (resultf < 2305843009213693952.0L)
+                continue;
+
+            d = d / resultf * 9223372036854775808.0L;
+            if (d > max_delta)
+            {
+                max_delta = d;
+                worst = a;
+            }
+        }
+
+        printf("Worst relative delta %0.2f * 2^-63 with input %lld\n", max_delta, (long long)worst);
+
+        TEST(max_delta < 8);
+    }
+
+    {
+        COMMENT("Testing fix32_ln() corner cases");
+        TEST(fix32_ln(fix32_one) == 0);
+        TEST(fix32_ln(fix32_e) == fix32_one);
+        TEST(fix32_ln(0) == fix32_minimum);
+        TEST(fix32_ln(-fix32_one) == fix32_minimum);
+        TEST(fix32_ln(1) == fix32_from_dbl(log(1.0 / 4294967296.0)));
+    }
+
+    {
+        COMMENT("Testing fix32_ln() accuracy over full range");
+
+        fix32_t max_delta = -1;
+        fix32_t worst = 0;
+        double sum = 0;
+        int count = 0;
+        fix32_t a;
+
+        // Geometric steps, about 4096 samples per octave.
+        for (a = 1; a > 0 && a < fix32_maximum - (fix32_maximum >> 12); a += (a >> 12) + 1)
+        {
+            fix32_t result = fix32_ln(a);
+            fix32_t resultf = (fix32_t)llroundl(logl((long double)a / 4294967296.0L) * 4294967296.0L);
+
+            fix32_t d = delta(result, resultf);
+            if (d > max_delta)
+            {
+                max_delta = d;
+                worst = a;
+            }
+
+            sum += d;
+            count++;
+        }
+
+        printf("Worst delta %lld with input %lld\n", (long long)max_delta, (long long)worst);
+        printf("Average delta %0.2f\n", sum / count);
+
+        TEST(max_delta <= 1);
+    }
+
+    {
+        COMMENT("Testing fix32_log2() and fix32_slog2()");
+        TEST(fix32_log2(fix32_one) == 0);
+        TEST(fix32_log2(1) == fix32_from_int(-32));
+        TEST(fix32_log2(fix32_from_int(1024)) == fix32_from_int(10));
+        TEST(fix32_log2(fix32_one >> 3) == fix32_from_int(-3));
+        TEST(fix32_log2(0) == fix32_overflow);
+        TEST(fix32_log2(-fix32_one) == fix32_overflow);
+        TEST(fix32_slog2(-fix32_one) == fix32_minimum);
+        TEST(fix32_slog2(fix32_from_int(8)) == fix32_from_int(3));
+
+        fix32_t max_delta = -1;
+        fix32_t worst = 0;
+        fix32_t a;
+
+        for (a = 1; a > 0 && a < fix32_maximum - (fix32_maximum >> 12); a += (a >> 12) + 1)
+        {
+            fix32_t result = fix32_log2(a);
+            fix32_t resultf = (fix32_t)llroundl(log2l((long double)a / 4294967296.0L) * 4294967296.0L);
+
+            fix32_t d = delta(result, resultf);
+            if (d > max_delta)
+            {
+                max_delta = d;
+                worst = a;
+            }
+        }
+
+        printf("Worst delta %lld with input %lld\n", (long long)max_delta, (long long)worst);
+
+        TEST(max_delta <= 1);
+    }
+
+    {
+        COMMENT("Testing fix32_pow2() and fix32_pow()");
+        TEST(fix32_pow2(0) == fix32_one);
+        TEST(fix32_pow2(fix32_one) == fix32_from_int(2));
+        TEST(fix32_pow2(-fix32_one) == fix32_one >> 1);
+        TEST(fix32_pow2(fix32_from_int(-32)) == 1);
+        TEST(fix32_pow2(fix32_from_int(-34)) == 0);
+        TEST(fix32_pow2(fix32_from_int(31)) == fix32_maximum);
+        TEST(fix32_pow2(fix32_minimum) == 0);
+        TEST(fix32_pow(fix32_from_int(2), fix32_from_int(10)) == fix32_from_int(1024));
+        TEST(delta(fix32_pow(fix32_from_int(10), fix32_from_int(-2)), 42949673) <= 1);
+        TEST(fix32_pow(fix32_from_int(-2), fix32_from_int(2)) == fix32_overflow);
+        TEST(fix32_spow(fix32_from_int(-2), fix32_from_int(2)) == fix32_minimum);
+        TEST(fix32_spow(fix32_from_dbl(312.456546), fix32_from_dbl(11.246556)) == fix32_maximum);
+
+        // Error in LSB, with a relative part of 2^-50 for large results
+        // that comes from rounding e * log2(b).
+        double max_delta = -1;
+        fix32_t a;
+        for (a = fix32_from_int(-35); a < fix32_from_int(32); a += 999983)
+        {
+            long double resultf = exp2l((long double)a / 4294967296.0L) * 4294967296.0L;
+            if (resultf > 9223372036854775807.0L)
+                resultf = 9223372036854775807.0L;
+            long double d = fabsl((long double)fix32_pow2(a) - resultf) / (1.0L + resultf / 1125899906842624.0L);
+            if (d > max_delta)
+                max_delta = d;
+        }
+        printf("pow2: worst delta %0.2f\n", max_delta);
+        TEST(max_delta <= 1);
+
+        max_delta = -1;
+        fix32_t b, e;
+        for (b = 1; b > 0 && b < fix32_from_int(100000); b += (b >> 4) + 1)
+        {
+            for (e = fix32_from_int(-20); e < fix32_from_int(20); e += 42949673)
+            {
+                long double resultf = powl((long double)b / 4294967296.0L, (long double)e / 4294967296.0L) * 4294967296.0L;
+                if (resultf > 9223372036854775807.0L)
+                    resultf = 9223372036854775807.0L;
+                long double d = fabsl((long double)fix32_pow(b, e) - resultf) / (1.0L + resultf / 1125899906842624.0L);
+                if (d > max_delta)
+                    max_delta = d;
+            }
+        }
+        printf("pow: worst delta %0.2f\n", max_delta);
+        TEST(max_delta <= 1);
+    }
+
+    {
+        COMMENT("Testing fix32_powi() and fix32_spowi()");
+        TEST(fix32_powi(fix32_from_int(3), 5) == fix32_from_int(243));
+        TEST(fix32_powi(fix32_from_int(-3), 3) == fix32_from_int(-27));
+        TEST(fix32_powi(fix32_from_int(-2), -3) == -(fix32_one >> 3));
+        TEST(fix32_powi(fix32_from_dbl(0.5), 32) == 1);
+        TEST(fix32_powi(fix32_from_dbl(0.5), 34) == 0);
+        TEST(fix32_powi(fix32_from_int(2), 30) == fix32_from_int(1 << 30));
+        TEST(fix32_powi(fix32_from_int(2), 31) == fix32_overflow);
+        TEST(fix32_powi(fix32_from_int(-7), 0) == fix32_one);
+        TEST(fix32_powi(0, 3) == 0);
+        TEST(fix32_powi(0, -1) == fix32_overflow);
+        TEST(delta(fix32_powi(fix32_one + 1, -2147483647 - 1), fix32_from_dbl(exp(-0.5))) <= 1);
+        TEST(fix32_spowi(fix32_from_int(10), 10) == fix32_maximum);
+        TEST(fix32_spowi(fix32_from_int(-10), 11) == fix32_minimum);
+        TEST(fix32_spowi(0, -2) == fix32_maximum);
+
+        // Error in LSB, less the relative error of |n| * 2^-64 that
+        // accumulates in the 64 bit intermediates.
+        double max_delta = -1;
+        fix32_t b;
+        int n;
+        for (b = 1; b > 0 && b < fix32_from_int(1000); b += (b >> 5) + 1)
+        {
+            for (n = -12; n <= 12; n++)
+            {
+                fix32_t bs = (n & 2) ? -b : b;
+                long double resultf = powl((long double)bs / 4294967296.0L, n) * 4294967296.0L;
+                if (fabsl(resultf) >= 9223372036854775807.0L)
+                {
+                    TEST(fix32_powi(bs, n) == fix32_overflow);
+                    continue;
+                }
+                long double d = fabsl((long double)fix32_powi(bs, n) - resultf)
+                    - fabsl(resultf) * (n < 0 ? -n : n) / 18446744073709551616.0L;
+                if (d > max_delta)
+                    max_delta = d;
+            }
+        }
+        printf("powi: worst delta %0.2f\n", max_delta);
+        TEST(max_delta <= 0.5);
+    }
+
+    {
+        COMMENT("Testing fix32_rootn()");
+        TEST(fix32_rootn(fix32_from_int(16), 4) == fix32_from_int(2));
+        TEST(fix32_rootn(fix32_from_int(-243), 5) == fix32_from_int(-3));
+        TEST(fix32_rootn(fix32_from_int(-27), 3) == fix32_from_int(-3));
+        TEST(fix32_rootn(fix32_from_int(-16), 4) == fix32_overflow);
+        TEST(fix32_rootn(fix32_from_int(5), 0) == fix32_overflow);
+        TEST(fix32_rootn(fix32_from_int(5), 1) == fix32_from_int(5));
+        TEST(fix32_rootn(0, 7) == 0);
+        TEST(fix32_rootn(1, 8) == fix32_one >> 4);
+
+        double max_delta = 0;
+        uint64_t seed = 3;
+        int i, n;
+        for (n = 4; n <= 200; n += (n < 70 ? 1 : 13))
+        {
+            for (i = 0; i < 2000; i++)
+            {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                fix32_t x = (fix32_t)seed >> ((seed >> 32) & 63);
+                if (!(n & 1) && x < 0)
+                    x = (x == fix32_minimum) ? fix32_maximum : -x;
+                long double resultf = powl(fabsl((long double)x) / 4294967296.0L, 1.0L / n) * 4294967296.0L;
+                long double d = fabsl(fabsl((long double)fix32_rootn(x, n)) - resultf);
+                if (d > max_delta)
+                    max_delta = d;
+            }
+        }
+        printf("rootn: worst delta %0.2f\n", max_delta);
+        TEST(max_delta <= 1);
+    }
+
+    {
+        COMMENT("Testing fix32_tanh(), fix32_sigmoid(), fix32_softplus() and fix32_gelu()");
+        TEST(fix32_tanh(0) == 0);
+        TEST(fix32_tanh(fix32_maximum) == fix32_one);
+        TEST(fix32_tanh(fix32_minimum) == -fix32_one);
+        TEST(fix32_sigmoid(0) == fix32_one / 2);
+        TEST(fix32_sigmoid(fix32_minimum) == 0);
+        TEST(delta(fix32_softplus(0), fix32_from_dbl(log(2.0))) <= 1);
+        TEST(fix32_softplus(fix32_maximum) == fix32_maximum);
+        TEST(fix32_gelu(fix32_minimum) == 0);
+        TEST(fix32_gelu(fix32_from_int(100)) == fix32_from_int(100));
+
+        double max_tanh = 0, max_sigmoid = 0, max_softplus = 0, max_gelu = 0;
+        fix32_t a;
+        for (a = fix32_from_int(-26); a < fix32_from_int(26); a += 1000003)
+        {
+            long double x = (long double)a / 4294967296.0L;
+            long double softplus = (x > 0) ? x + log1pl(expl(-x)) : log1pl(expl(x));
+            long double d;
+
+            d = fabsl(fix32_tanh(a) - tanhl(x) * 4294967296.0L);
+            if (d > max_tanh) max_tanh = d;
+            d = fabsl(fix32_sigmoid(a) - 4294967296.0L / (1 + expl(-x)));
+            if (d > max_sigmoid) max_sigmoid = d;
+            d = fabsl(fix32_softplus(a) - softplus * 4294967296.0L);
+            if (d > max_softplus) max_softplus = d;
+            d = fabsl(fix32_gelu(a) - x * 0.5L * erfcl(-x / sqrtl(2)) * 4294967296.0L);
+            if (d > max_gelu) max_gelu = d;
+        }
+
+        printf("Worst delta tanh %0.2f, sigmoid %0.2f, softplus %0.2f, gelu %0.2f\n",
+            max_tanh, max_sigmoid, max_softplus, max_gelu);
+        TEST(max_tanh <= 1);
+        TEST(max_sigmoid <= 1);
+        TEST(max_softplus <= 1);
+        TEST(max_gelu <= 1);
+
+        // The array forms give the same results, also in place.
+        fix32_t in[37], out[37];
+        int i, same = 1;
+        for (i = 0; i < 37; i++)
+            in[i] = out[i] = fix32_from_int(i - 18) / 3;
+        fix32_tanh_array(in, out, 37);
+        for (i = 0; i < 37; i++)
+            same &= (out[i] == fix32_tanh(in[i]));
+        fix32_sigmoid_array(in, out, 37);
+        for (i = 0; i < 37; i++)
+            same &= (out[i] == fix32_sigmoid(in[i]));
+        fix32_softplus_array(in, out, 37);
+        for (i = 0; i < 37; i++)
+            same &= (out[i] == fix32_softplus(in[i]));
+        fix32_gelu_array(in, in, 37);
+        for (i = 0; i < 37; i++)
+            same &= (in[i] == fix32_gelu(fix32_from_int(i - 18) / 3));
+        TEST(same);
+    }
+
+    {
+        COMMENT("Testing fix32_expm1() and fix32_log1p()");
+        TEST(fix32_expm1(0) == 0);
+        TEST(fix32_expm1(1) == 1);
+        TEST(fix32_expm1(-1) == -1);
+        TEST(fix32_expm1(fix32_minimum) == -fix32_one);
+        TEST(fix32_expm1(fix32_maximum) == fix32_maximum);
+        TEST(fix32_log1p(0) == 0);
+        TEST(fix32_log1p(1) == 1);
+        TEST(fix32_log1p(-fix32_one) == fix32_minimum);
+        TEST(delta(fix32_log1p(fix32_maximum), fix32_from_dbl(log(2147483649.0))) <= 1);
+
+        double max_expm1 = 0, max_log1p = 0;
+        fix32_t a;
+        for (a = -fix32_one / 2; a < fix32_one / 2; a += 9973)
+        {
+            long double x = (long double)a / 4294967296.0L;
+            long double d = fabsl(fix32_expm1(a) - expm1l(x) * 4294967296.0L);
+            if (d > max_expm1) max_expm1 = d;
+            d = fabsl(fix32_log1p(a) - log1pl(x) * 4294967296.0L);
+            if (d > max_log1p) max_log1p = d;
+        }
+        for (a = fix32_from_int(-30); a < fix32_from_int(4); a += 999983)
+        {
+            long double d = fabsl(fix32_expm1(a) - expm1l((long double)a / 4294967296.0L) * 4294967296.0L);
+            if (d > max_expm1) max_expm1 = d;
+        }
+
+        printf("Worst delta expm1 %0.2f, log1p %0.2f\n", max_expm1, max_log1p);
+        TEST(max_expm1 <= 1);
+        TEST(max_log1p <= 1);
+    }
+
+    {
+        COMMENT("Testing fix32_log10(), fix32_exp10() and the decibel conversions");
+        TEST(fix32_log10(fix32_from_int(1000)) == fix32_from_int(3));
+        TEST(fix32_log10(fix32_one) == 0);
+        TEST(fix32_log10(0) == fix32_minimum);
+        TEST(fix32_exp10(fix32_from_int(2)) == fix32_from_int(100));
+        TEST(fix32_exp10(fix32_from_int(-1)) == 429496730);
+        TEST(fix32_exp10(fix32_from_int(10)) == fix32_maximum);
+        TEST(fix32_exp10(fix32_from_int(-11)) == 0);
+        TEST(fix32_to_db_power(fix32_from_int(100)) == fix32_from_int(20));
+        TEST(fix32_to_db_amplitude(fix32_from_int(10)) == fix32_from_int(20));
+        TEST(fix32_to_db_amplitude(-fix32_one) == fix32_minimum);
+        TEST(fix32_from_db(fix32_from_int(-20)) == 429496730);
+        TEST(fix32_from_db(fix32_from_int(40)) == fix32_from_int(100));
+
+        double max_log = 0, max_exp = 0;
+        fix32_t a;
+        for (a = 1; a > 0 && a < fix32_maximum - (fix32_maximum >> 12); a += (a >> 12) + 1)
+        {
+            long double l = log10l((long double)a / 4294967296.0L);
+            long double d = fabsl(fix32_log10(a) - l * 4294967296.0L);
+            if (d > max_log) max_log = d;
+            d = fabsl(fix32_to_db_power(a) - 10 * l * 4294967296.0L);
+            if (d > max_log) max_log = d;
+            d = fabsl(fix32_to_db_amplitude(a) - 20 * l * 4294967296.0L);
+            if (d > max_log) max_log = d;
+        }
+        // Error in LSB, less 2^-60 relative for large results.
+        for (a = fix32_from_int(-11); a < fix32_from_int(10); a += 999983)
+        {
+            long double resultf = powl(10, (long double)a / 4294967296.0L) * 4294967296.0L;
+            if (resultf > 9223372036854775807.0L)
+                resultf = 9223372036854775807.0L;
+            long double d = fabsl(fix32_exp10(a) - resultf) - resultf / 1152921504606846976.0L;
+            if (d > max_exp) max_exp = d;
+
+            resultf = powl(10, (long double)a / 4294967296.0L / 2) * 4294967296.0L;
+            d = fabsl(fix32_from_db(a * 10) - resultf) - resultf / 1152921504606846976.0L;
+            if (d > max_exp) max_exp = d;
+        }
+
+        printf("Worst delta log10 %0.2f, exp10 %0.2f\n", max_log, max_exp);
+        TEST(max_log <= 1);
+        TEST(max_exp <= 1);
+
+        fix32_t in[33], out[33];
+        int i, same = 1;
+        for (i = 0; i < 33; i++)
+            in[i] = fix32_from_int(i - 16) / 2;
+        fix32_exp10_array(in, out, 33);
+        fix32_from_db_array(in, in, 33);
+        for (i = 0; i < 33; i++)
+            same &= (out[i] == fix32_exp10(fix32_from_int(i - 16) / 2))
+                && (in[i] == fix32_from_db(fix32_from_int(i - 16) / 2));
+        fix32_log10_array(out, in, 33);
+        for (i = 0; i < 33; i++)
+            same &= (in[i] == fix32_log10(out[i]));
+        fix32_to_db_power_array(out, in, 33);
+        for (i = 0; i < 33; i++)
+            same &= (in[i] == fix32_to_db_power(out[i]));
+        for (i = 0; i < 33; i++)
+            in[i] = fix32_to_db_amplitude(out[i]);
+        fix32_to_db_amplitude_array(out, out, 33);
+        for (i = 0; i < 33; i++)
+            same &= (out[i] == in[i]);
+        TEST(same);
+    }
+
+    {
+        COMMENT("Testing fix32_exp_array(), fix32_ln_array(), fix32_log2_array() and fix32_pow2_array()");
+
+        // Odd length, so that the masked tail of the SIMD kernels is used.
+        #define ARRAY_LEN 1003
+        fix32_t in[ARRAY_LEN], out[ARRAY_LEN];
+        fix32_t max_delta = 0;
+        uint64_t seed = 1;
+        int i, j, within = 1;
+        for (j = 0; j < 4; j++)
+        {
+            for (i = 0; i < ARRAY_LEN; i++)
+            {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                in[i] = (fix32_t)seed >> (seed & 63);
+            }
+            in[0] = 0;
+            in[1] = fix32_maximum;
+            in[2] = fix32_minimum;
+            in[3] = 1;
+            in[4] = fix32_one;
+            in[5] = 92288378626LL;
+            in[6] = -98242467570LL;
+            in[7] = fix32_from_int(31);
+            in[8] = fix32_from_int(-34) - 1;
+
+            if (j == 0) fix32_exp_array(in, out, ARRAY_LEN);
+            if (j == 1) fix32_ln_array(in, out, ARRAY_LEN);
+            if (j == 2) fix32_log2_array(in, out, ARRAY_LEN);
+            if (j == 3) fix32_pow2_array(in, out, ARRAY_LEN);
+            for (i = 0; i < ARRAY_LEN; i++)
+            {
+                fix32_t expected = (j == 0) ? fix32_exp(in[i]) : (j == 1) ? fix32_ln(in[i])
+                    : (j == 2) ? fix32_log2(in[i]) : fix32_pow2(in[i]);
+                // 1 LSB, or 2^-50 relative for large exponentials.
+                fix32_t d = delta(out[i], expected) - ((j == 0 || j == 3) ? expected >> 50 : 0);
+                if (d > max_delta) max_delta = d;
+            }
+        }
+
+        printf("[exp, ln, log2, pow2 arrays]: max difference: %lld LSB\n", (long long)max_delta);
+        TEST(max_delta <= 1);
+
+        // In place.
+        for (i = 0; i < 3; i++)
+            in[i] = fix32_from_int(i + 1);
+        fix32_ln_array(in, in, 3);
+        for (i = 0; i < 3; i++)
+            within &= delta(in[i], fix32_ln(fix32_from_int(i + 1))) <= 1;
+        fix32_exp_array(in, in, 3);
+        for (i = 0; i < 3; i++)
+            within &= delta(in[i], fix32_from_int(i + 1)) <= 2;
+        TEST(within);
+        #undef ARRAY_LEN
+    }
+
+    {
+        COMMENT("Testing precision tiers of exp, ln, log2 and pow2");
+
+        fix32_t (*const tiers[])(fix32_t) = { fix32_exp_fast, fix32_exp_mid, fix32_pow2_fast, fix32_pow2_mid,
+                                              fix32_ln_fast, fix32_ln_mid, fix32_log2_fast, fix32_log2_mid };
+        const char *names[] = { "exp_fast", "exp_mid", "pow2_fast", "pow2_mid",
+                                "ln_fast", "ln_mid", "log2_fast", "log2_mid" };
+        int t, i;
+        for (t = 0; t < 8; t++)
+        {
+            double max_err = 0;
+            uint64_t seed = 1;
+            for (i = 0; i < 200000; i++)
+            {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                fix32_t x;
+                long double real, resultf;
+                if (t < 4)
+                {
+                    // Up to the saturation of the results.
+                    x = (fix32_t)seed >> 28;
+                    real = (long double)x / 4294967296.0L;
+                    resultf = (t < 2) ? expl(real) : exp2l(real);
+                    if (resultf >= 2147483648.0L)
+                        continue;
+                }
+                else
+                {
+                    x = (fix32_t)(seed >> 1) >> (seed & 63);
+                    if (x <= 0)
+                        continue;
+                    real = (long double)x / 4294967296.0L;
+                    resultf = (t < 6) ? logl(real) : log2l(real);
+                }
+                double err = fabsl((long double)tiers[t](x) / 4294967296.0L - resultf);
+                if (t < 4 && resultf > 1)
+                    err /= resultf;
+                if (err > max_err) max_err = err;
+            }
+            printf("[%s]: max error: %.3g\n", names[t], max_err);
+            TEST(max_err < ((t & 1) ? 1.0 / 16777216 : 1.0 / 65536));
+        }
+
+        TEST(fix32_exp_fast(fix32_maximum) == fix32_maximum);
+        TEST(fix32_exp_mid(fix32_minimum) == 0);
+        TEST(fix32_pow2_mid(fix32_from_int(31)) == fix32_maximum);
+        TEST(fix32_pow2_fast(fix32_from_int(-35)) == 0);
+        TEST(fix32_ln_fast(0) == fix32_minimum);
+        TEST(fix32_log2_mid(-fix32_one) == fix32_overflow);
+    }
+
+    if (status != 0)
+    fprintf(stdout, "\n\nSome tests FAILED!\n");
+
+    return status;
+}
@@ -0,0 +1,343 @@
+#include "../libfixmath/fix32.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "unittests.h"
+
+static uint64_t seed = 29;
+
+static uint64_t next_random(void)
+{
+  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return seed ^ (seed >> 31);
+}
+
+/* Exact round(F * 2^32 / 10^k), ties to even, for up to 19 digits. */
+static fix32_t reference_from_digits(bool negative, uint64_t intpart, uint64_t f, int k)
+{
+  unsigned __int128 p10 = 1;
+  int i;
+  for (i = 0; i < k; i++)
+    p10 *= 10;
+  unsigned __int128 num = (unsigned __int128)f << 32;
+  uint64_t q = (uint64_t)(num / p10);
+  unsigned __int128 rem = num % p10;
+  if (2 * rem > p10 || (2 * rem == p10 && (q & 1)))
+    q++;
+  uint64_t mag = (intpart << 32) + q;
+  return negative ? (fix32_t)(0 - mag) : (fix32_t)mag;
+}
+
+int main()
+{
+  int status = 0;
+
+  {
+    COMMENT("Testing fix32_to_str corner cases");
+    char buf[64];
+
+    fix32_to_str(fix32_from_dbl(1234.5678), buf, 4);
+    printf("1234.5678 = %s\n", buf);
+    TEST(strcmp(buf, "1234.5678") == 0);
+
+    fix32_to_str(fix32_from_dbl(-1234.5678), buf, 4);
+    printf("-1234.5678 = %s\n", buf);
+    TEST(strcmp(buf, "-1234.5678") == 0);
+
+    fix32_to_str(0, buf, 0);
+    TEST(strcmp(buf, "0") == 0);
+
+    fix32_to_str(fix32_from_dbl(0.9999), buf, 3);
+    TEST(strcmp(buf, "1.000") == 0);
+
+    fix32_to_str(fix32_one / 2, buf, 0);
+    TEST(strcmp(buf, "0") == 0);
+
+    fix32_to_str(fix32_one + fix32_one / 2, buf, 0);
+    TEST(strcmp(buf, "2") == 0);
+
+    fix32_to_str(fix32_maximum, buf, 32);
+    printf("fix32_maximum = %s\n", buf);
+    TEST(strcmp(buf, "2147483647.99999999976716935634613037109375") == 0);
+
+    fix32_to_str(fix32_minimum, buf, 10);
+    TEST(strcmp(buf, "-2147483648.0000000000") == 0);
+
+    fix32_to_str(fix32_maximum, buf, 9);
+    TEST(strcmp(buf, "2147483648.000000000") == 0);
+
+    // More than 32 decimals would only add zeros.
+    fix32_to_str(1, buf, 40);
+    TEST(strcmp(buf, "0.00000000023283064365386962890625") == 0);
+
+    fix32_to_str(fix32_from_int(5), buf, -1);
+    TEST(strcmp(buf, "5") == 0);
+  }
+
+  {
+    COMMENT("Testing fix32_to_str against printf");
+    // Values with up to 53 significant bits are exact doubles, and printf
+    // rounds their exact decimal expansion to nearest, ties to even.
+    char buf[64], expected[64];
+    int i, failures = 0;
+    for (i = 0; i < 200000; i++)
+    {
+      uint64_t r = next_random();
+      fix32_t value = (fix32_t)r >> (11 + r % 53);
+      int decimals = (int)(next_random() % 33);
+      fix32_to_str(value, buf, decimals);
+      snprintf(expected, sizeof(expected), "%.*f", decimals, value / 4294967296.0);
+      if (strcmp(buf, expected) != 0)
+      {
+        if (failures < 5)
+          printf("%s != %s\n", buf, expected);
+        failures++;
+      }
+    }
+    TEST(failures == 0);
+  }
+
+  {
+    COMMENT("Testing fix32_from_str corner cases");
+    TEST(fix32_from_str("1234.5678") == reference_from_digits(false, 1234, 5678, 4));
+    TEST(fix32_from_str("-1234.5678") == reference_from_digits(true, 1234, 5678, 4));
+    TEST(fix32_from_str("   +1234,5678   ") == reference_from_digits(false, 1234, 5678, 4));
+    TEST(fix32_from_str("0") == 0);
+    TEST(fix32_from_str("-0.0") == 0);
+    TEST(fix32_from_str("5.") == fix32_from_int(5));
+    TEST(fix32_from_str("0.5") == fix32_one / 2);
+    TEST(fix32_from_str("2147483647.99999999976716935634613037109375") == fix32_maximum);
+    TEST(fix32_from_str("2147483647.9999999999") == fix32_overflow);
+    TEST(fix32_from_str("-2147483648") == fix32_minimum);
+    TEST(fix32_from_str("2147483648") == fix32_overflow);
+    TEST(fix32_from_str("99999999999999999999") == fix32_overflow);
+    TEST(fix32_from_str("000000000000000000012.25") == fix32_from_int(12) + fix32_one / 4);
+    TEST(fix32_from_str("") == fix32_overflow);
+    TEST(fix32_from_str("-") == fix32_overflow);
+    TEST(fix32_from_str(".5") == fix32_overflow);
+    TEST(fix32_from_str("1.5x") == fix32_overflow);
+    TEST(fix32_from_str("1 2") == fix32_overflow);
+    TEST(fix32_from_str("0x10") == fix32_overflow);
+  }
+
+  {
+    COMMENT("Testing fix32_from_str rounding");
+    // Random strings with up to 18 decimals against exact integer math.
+    char buf[64];
+    int i, failures = 0;
+    for (i = 0; i < 200000; i++)
+    {
+      bool negative = next_random() & 1;
+      uint64_t intpart = next_random() % 2147483648u;
+      int k = (int)(next_random() % 19);
+      uint64_t f = 0;
+      int j, pos = sprintf(buf, "%s%llu.", negative ? "-" : "", (unsigned long long)intpart);
+      for (j = 0; j < k; j++)
+      {
+        int d = (int)(next_random() % 10);
+        buf[pos++] = (char)('0' + d);
+        f = f * 10 + d;
+      }
+      buf[pos] = '\0';
+      fix32_t expected = reference_from_digits(negative, intpart, f, k);
+      if (fix32_from_str(buf) != expected)
+      {
+        if (failures < 5)
+          printf("%s\n", buf);
+        failures++;
+      }
+    }
+    TEST(failures == 0);
+
+    // Exact midpoints between two values have 33 decimals. Ties go to the
+    // even value, and anything above or below, however far down in the
+    // digits, decides the rounding.
+    failures = 0;
+    for (i = 0; i < 20000; i++)
+    {
+      uint64_t q = next_random() & 0xFFFFFFFF;
+      int len = sprintf(buf, "%.33f", (2 * q + 1) / 8589934592.0);
+      fix32_t down = (fix32_t)q, up = (fix32_t)q + 1;
+      failures += (fix32_from_str(buf) != ((q & 1) ? up : down));
+      strcat(buf, "00000000000000000001");
+      failures += (fix32_from_str(buf) != up);
+      buf[len - 1] = '4';
+      strcpy(buf + len, "9999999999999999999999");
+      failures += (fix32_from_str(buf) != down);
+    }
+    TEST(failures == 0);
+  }
+
+  {
+    COMMENT("Testing round trips");
+    // 10 decimals are closer than half of 2^-32, so they parse back to
+    // the same value, and 32 decimals are exact.
+    char buf[64];
+    int i, failures = 0;
+    for (i = 0; i < 200000; i++)
+    {
+      uint64_t r = next_random();
+      fix32_t value = (fix32_t)r >> (r % 64);
+      fix32_to_str(value, buf, 10);
+      failures += (fix32_from_str(buf) != value);
+      fix32_to_str(value, buf, 32);
+      failures += (fix32_from_str(buf) != value);
+    }
+    TEST(failures == 0);
+  }
+
+  {
+    COMMENT("Testing fix32_parse_buffer");
+    // Random entries of every length, each compared with fix32_from_str.
+    enum { COUNT = 20000 };
+    static char text[COUNT * 48];
+    static fix32_t values[COUNT], expected[COUNT];
+    char entry[48];
+    size_t len = 0, stop;
+    int i, failures = 0;
+    for (i = 0; i < COUNT; i++)
+    {
+      uint64_t r = next_random();
+      fix32_t value = (fix32_t)r >> (r % 64);
+      fix32_to_str(value, entry, (int)(next_random() % 33));
+      if (i % 7 == 0 && strchr(entry, '.'))
+        strcat(entry, "0000000000000000000001");
+      expected[i] = fix32_from_str(entry);
+      len += sprintf(text + len, "%s%s%s", (i % 5 == 0) ? " " : "", entry,
+        (i % 3 == 0) ? "\r\n" : ",");
+    }
+    size_t n = fix32_parse_buffer(text, len, values, COUNT, ',', &stop);
+    for (i = 0; i < COUNT; i++)
+      failures += (values[i] != expected[i]);
+    TEST(n == COUNT && stop == len && failures == 0);
+
+    // Stops at malformed entries and when out is full.
+    const char *csv = "1.5, -2.25 ,3\n4.,+5,";
+    n = fix32_parse_buffer(csv, strlen(csv), values, COUNT, ',', &stop);
+    TEST(n == 5 && stop == strlen(csv) && values[1] == -fix32_from_int(2) - fix32_one / 4 && values[4] == fix32_from_int(5));
+    n = fix32_parse_buffer(csv, strlen(csv), values, 2, ',', &stop);
+    TEST(n == 2 && stop == 12);
+    csv = "1,2,,3";
+    n = fix32_parse_buffer(csv, strlen(csv), values, COUNT, ',', &stop);
+    TEST(n == 2 && stop == 4);
+    csv = "12345678901234.5;7";
+    n = fix32_parse_buffer(csv, strlen(csv), values, COUNT, ';', &stop);
+    TEST(n == 0 && stop == 0);
+    csv = "0.25\t;\t-x";
+    n = fix32_parse_buffer(csv, strlen(csv), values, COUNT, ';', &stop);
+    TEST(n == 1 && stop == 7 && values[0] == fix32_one / 4);
+    csv = "1 2 3.5";
+    n = fix32_parse_buffer(csv, strlen(csv), values, COUNT, ' ', &stop);
+    TEST(n == 3 && stop == strlen(csv) && values[2] == fix32_from_int(3) + fix32_one / 2);
+    TEST(fix32_parse_buffer("", 0, values, COUNT, ',', &stop) == 0 && stop == 0);
+  }
+
+  {
+    COMMENT("Testing fix32_to_str_shortest");
+    char buf[64];
+    fix32_to_str_shortest(0, buf);
+    TEST(strcmp(buf, "0") == 0);
+    fix32_to_str_shortest(fix32_from_int(-7), buf);
+    TEST(strcmp(buf, "-7") == 0);
+    fix32_to_str_shortest(-fix32_one - fix32_one / 4, buf);
+    TEST(strcmp(buf, "-1.25") == 0);
+    fix32_to_str_shortest(fix32_minimum, buf);
+    TEST(strcmp(buf, "-2147483648") == 0);
+    fix32_to_str_shortest(fix32_maximum, buf);
+    printf("fix32_maximum = %s\n", buf);
+    TEST(strcmp(buf, "2147483647.9999999998") == 0);
+#ifndef FIXMATH_NO_ROUNDING
+    fix32_to_str_shortest(429496730, buf);
+    TEST(strcmp(buf, "0.1") == 0);
+    fix32_to_str_shortest(1, buf);
+    TEST(strcmp(buf, "0.0000000002") == 0);
+#else
+    fix32_to_str_shortest(429496730, buf);
+    TEST(strcmp(buf, "0.1000000001") == 0);
+    fix32_to_str_shortest(1, buf);
+    TEST(strcmp(buf, "0.0000000003") == 0);
+#endif
+
+    // Each string parses back, no string with fewer decimals does, and
+    // when the nearest one with as many decimals parses back, it is the
+    // same string. The candidates with j decimals are the two around the
+    // value.
+    char candidate[64];
+    int i, j, failures = 0;
+    for (i = 0; i < 200000; i++)
+    {
+      uint64_t r = next_random();
+      fix32_t value = (fix32_t)r >> (r % 64);
+      fix32_to_str_shortest(value, buf);
+      failures += (fix32_from_str(buf) != value);
+
+      const char *point = strchr(buf, '.');
+      int decimals = point ? (int)strlen(point + 1) : 0;
+      uint64_t mag = (value < 0) ? 0 - (uint64_t)value : (uint64_t)value;
+      uint64_t p10 = 1;
+      for (j = 0; j < decimals; j++)
+      {
+        unsigned __int128 scaled = (unsigned __int128)(mag & 0xFFFFFFFF) * p10;
+        uint64_t below = (uint64_t)(scaled >> 32), d;
+        for (d = below; d <= below + 1; d++)
+        {
+          uint64_t intpart = (mag >> 32) + d / p10, digits = d % p10;
+          int k, len = snprintf(candidate, sizeof(candidate), "%s%llu", (value < 0) ? "-" : "",
+            (unsigned long long)intpart);
+          if (j > 0)
+          {
+            candidate[len] = '.';
+            for (k = j; k > 0; k--, digits /= 10)
+              candidate[len + k] = (char)('0' + digits % 10);
+            candidate[len + j + 1] = '\0';
+          }
+          failures += (fix32_from_str(candidate) == value);
+        }
+        p10 *= 10;
+      }
+
+      fix32_to_str(value, candidate, decimals);
+      if (fix32_from_str(candidate) == value)
+        failures += (strcmp(candidate, buf) != 0);
+    }
+    TEST(failures == 0);
+  }
+
+  {
+    COMMENT("Testing fix32_format_array");
+    enum { COUNT = 20000 };
+    static char text[COUNT * 23];
+    static fix32_t values[COUNT], parsed[COUNT];
+    char buf[64];
+    size_t len, stop, n, expected = 0;
+    int i, failures = 0;
+    for (i = 0; i < COUNT; i++)
+    {
+      uint64_t r = next_random();
+      values[i] = (fix32_t)r >> (r % 64);
+      fix32_to_str_shortest(values[i], buf);
+      expected += strlen(buf) + 1;
+    }
+    n = fix32_format_array(values, COUNT, text, sizeof(text), '\n', &len);
+    TEST(n == COUNT && len == expected - 1 && strlen(text) == len);
+    n = fix32_parse_buffer(text, len, parsed, COUNT, '\n', &stop);
+    for (i = 0; i < COUNT; i++)
+      failures += (parsed[i] != values[i]);
+    TEST(n == COUNT && stop == len && failures == 0);
+
+    // Only whole entries are written, with room for the terminator.
+    fix32_t few[3] = { fix32_from_int(12), -fix32_one / 2, fix32_one / 4 };
+    n = fix32_format_array(few, 3, buf, 10, ';', &len);
+    TEST(n == 2 && len == 7 && strcmp(buf, "12;-0.5") == 0);
+    n = fix32_format_array(few, 3, buf, 13, ';', &len);
+    TEST(n == 3 && len == 12 && strcmp(buf, "12;-0.5;0.25") == 0);
+    n = fix32_format_array(few, 3, buf, 2, ';', &len);
+    TEST(n == 0 && len == 0 && buf[0] == '\0');
+    TEST(fix32_format_array(few, 3, buf, 0, ';', &len) == 0 && len == 0);
+  }
+
+  if (status != 0)
+    fprintf(stdout, "\n\nSome tests FAILED!\n");
+
+  return status;
+}
@@ -5,6 +5,8 @@
 #include "unittests.h"
 #include <math.h>
 #include <inttypes.h>
+#include <string.h>
+#include <fenv.h>
 
 const fix32_t testcases[] = {
   // Small numbers
@@ -203,6 +205,365 @@ int main()
 	  }
 	  printf("[acos]: max error: %.10f, when value = %.10f\n", max_err, max_err_angle);
   }
+
+  {
+	  COMMENT("Testing binary float conversions");
+	  // Every float bit pattern against the FPU, in chunks through the
+	  // array versions. Fix32 values that are floats must convert back.
+	  enum { CHUNK = 4096 };
+	  static uint32_t bits[CHUNK], back[CHUNK];
+	  static fix32_t values[CHUNK];
+	  uint64_t from_failures = 0, to_failures = 0;
+	  uint64_t base;
+	  for (base = 0; base < 0x100000000ULL; base += CHUNK)
+	  {
+		  int i;
+		  for (i = 0; i < CHUNK; i++)
+			  bits[i] = (uint32_t)(base + i);
+		  fix32_from_float_bin_array(bits, values, CHUNK);
+		  float_from_fix32_bin_array(values, back, CHUNK);
+		  for (i = 0; i < CHUNK; i++)
+		  {
+			  float f;
+			  memcpy(&f, &bits[i], sizeof(f));
+			  double d = (double)f * 4294967296.0;
+			  fix32_t expected;
+			  if (isnan(d))
+				  expected = fix32_overflow;
+			  else if (d >= 9223372036854775808.0)
+				  expected = fix32_maximum;
+			  else if (d <= -9223372036854775808.0)
+				  expected = fix32_minimum;
+			  else
+#ifndef FIXMATH_NO_ROUNDING
+				  expected = (fix32_t)nearbyint(d);
+#else
+				  expected = (fix32_t)trunc(d);
+#endif
+			  from_failures += (values[i] != expected);
+			  if (d != 0 && d == floor(d) && d < 9223372036854775808.0 && d >= -9223372036854775808.0)
+				  to_failures += (back[i] != bits[i]);
+		  }
+	  }
+	  printf("[fix32_from_float_bin]: %" PRIu64 " failures, [float_from_fix32_bin]: %" PRIu64 " failures\n",
+		  from_failures, to_failures);
+	  TEST(from_failures == 0 && to_failures == 0);
+
+	  // The rounding of float_from_fix32_bin, against the FPU.
+	  uint64_t seed = 19;
+	  int i;
+	  to_failures = 0;
+#ifdef FIXMATH_NO_ROUNDING
+	  fesetround(FE_TOWARDZERO);
+#endif
+	  for (i = 0; i < 1000000; i++)
+	  {
+		  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		  fix32_t x = (fix32_t)seed >> ((seed >> 32) & 63);
+		  float f = (float)x / 4294967296.0f;
+		  uint32_t expected;
+		  memcpy(&expected, &f, sizeof(expected));
+		  to_failures += (float_from_fix32_bin(x) != expected);
+	  }
+	  fesetround(FE_TONEAREST);
+	  TEST(to_failures == 0);
+
+	  float f = -1.5f;
+	  TEST(fix32_from_float_bin(&f) == -fix32_one - fix32_one / 2);
+	  TEST(float_from_fix32_bin(0) == 0);
+	  TEST(float_from_fix32_bin(fix32_one) == 0x3F800000);
+	  TEST(float_from_fix32_bin(fix32_minimum) == 0xCF000000);
+#ifndef FIXMATH_NO_ROUNDING
+	  TEST(float_from_fix32_bin(fix32_maximum) == 0x4F000000);
+#else
+	  TEST(float_from_fix32_bin(fix32_maximum) == 0x4EFFFFFF);
+#endif
+	  TEST(float_from_fix32_bin(1) == 0x2F800000);
+  }
+
+  {
+	  COMMENT("Testing binary double conversions");
+	  // Random bit patterns, half of them with exponents around the
+	  // fix32_t range, against the FPU.
+	  enum { COUNT = 4096 };
+	  static uint64_t bits[COUNT], back[COUNT];
+	  static fix32_t values[COUNT];
+	  uint64_t from_failures = 0, to_failures = 0;
+	  uint64_t seed = 23;
+	  int round, i;
+	  for (round = 0; round < 256; round++)
+	  {
+		  for (i = 0; i < COUNT; i++)
+		  {
+			  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			  bits[i] = seed ^ (seed >> 29);
+			  if (i & 1)
+				  bits[i] = (bits[i] & 0x800FFFFFFFFFFFFFULL) | ((uint64_t)(1023 - 40 + (seed >> 57)) << 52);
+		  }
+		  fix32_from_double_bin_array(bits, values, COUNT);
+		  double_bin_from_fix32_array(values, back, COUNT);
+		  for (i = 0; i < COUNT; i++)
+		  {
+			  double d;
+			  memcpy(&d, &bits[i], sizeof(d));
+			  fix32_t expected;
+			  if (isnan(d))
+				  expected = fix32_overflow;
+			  else if (d >= 2147483648.0)
+				  expected = fix32_maximum;
+			  else if (d <= -2147483648.0)
+				  expected = fix32_minimum;
+			  else
+#ifndef FIXMATH_NO_ROUNDING
+				  expected = (fix32_t)nearbyintl((long double)d * 4294967296.0L);
+#else
+				  expected = (fix32_t)truncl((long double)d * 4294967296.0L);
+#endif
+			  from_failures += (values[i] != expected);
+			  if (d != 0 && values[i] == (long double)d * 4294967296.0L)
+				  to_failures += (back[i] != bits[i]);
+		  }
+	  }
+	  printf("[fix32_from_double_bin]: %" PRIu64 " failures, [double_bin_from_fix32]: %" PRIu64 " failures\n",
+		  from_failures, to_failures);
+	  TEST(from_failures == 0 && to_failures == 0);
+
+	  // The rounding of double_bin_from_fix32, against the FPU.
+	  to_failures = 0;
+#ifdef FIXMATH_NO_ROUNDING
+	  fesetround(FE_TOWARDZERO);
+#endif
+	  for (i = 0; i < 1000000; i++)
+	  {
+		  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		  fix32_t x = (fix32_t)seed >> ((seed >> 32) & 63);
+		  double d = (double)x / 4294967296.0;
+		  uint64_t expected;
+		  memcpy(&expected, &d, sizeof(expected));
+		  to_failures += (double_bin_from_fix32(x) != expected);
+	  }
+	  fesetround(FE_TONEAREST);
+	  TEST(to_failures == 0);
+
+	  TEST(fix32_from_double_bin(0x3FF8000000000000ULL) == fix32_one + fix32_one / 2);
+	  TEST(fix32_from_double_bin(0xFFF0000000000000ULL) == fix32_minimum);
+	  TEST(fix32_from_double_bin(0x7FF0000000000000ULL) == fix32_maximum);
+	  TEST(fix32_from_double_bin(0x8000000000000000ULL) == 0);
+	  TEST(double_bin_from_fix32(0) == 0);
+	  TEST(double_bin_from_fix32(-fix32_one) == 0xBFF0000000000000ULL);
+	  TEST(double_bin_from_fix32(fix32_minimum) == 0xC1E0000000000000ULL);
+	  TEST(double_bin_from_fix32(1) == 0x3DF0000000000000ULL);
+  }
+
+  {
+	  COMMENT("Testing sine and cosine arrays");
+	  // Odd length, to also go through the tail of the vector kernels.
+	  enum { ARRAY_LEN = 1001 };
+	  fix32_t angles[ARRAY_LEN], sines[ARRAY_LEN], cosines[ARRAY_LEN];
+	  for (int i = 0; i < ARRAY_LEN; ++i)
+		  angles[i] = (fix32_t)((uint64_t)(i - ARRAY_LEN / 2) * 0x3C6EF372FE94F82BULL);
+	  angles[0] = fix32_maximum;
+	  angles[1] = fix32_minimum;
+	  fix32_sin_array(angles, sines, ARRAY_LEN);
+	  fix32_cos_array(angles, cosines, ARRAY_LEN);
+	  fix32_t max_diff = 0;
+	  for (int i = 0; i < ARRAY_LEN; ++i)
+	  {
+		  if (delta(sines[i], fix32_sin(angles[i])) > max_diff)
+			  max_diff = delta(sines[i], fix32_sin(angles[i]));
+		  if (delta(cosines[i], fix32_cos(angles[i])) > max_diff)
+			  max_diff = delta(cosines[i], fix32_cos(angles[i]));
+	  }
+	  printf("[sin_array, cos_array]: max difference: %lld LSB\n", (long long)max_diff);
+	  TEST(max_diff <= 1);
+
+	  // In place, and the length is respected.
+	  fix32_t next = angles[3];
+	  fix32_sin_array(angles, angles, 3);
+	  TEST(angles[0] == sines[0] && angles[2] == sines[2] && angles[3] == next);
+  }
+
+  {
+	  COMMENT("Testing arcsine and arccosine accuracy");
+	  double max_err_asin = 0, max_err_acos = 0;
+	  fix32_t x;
+	  for (x = -fix32_one; x <= fix32_one; x += 65521)
+	  {
+		  double dx = fix32_to_dbl(x);
+		  double err_asin = fabs(fix32_to_dbl(fix32_asin(x)) - asin(dx));
+		  double err_acos = fabs(fix32_to_dbl(fix32_acos(x)) - acos(dx));
+		  max_err_asin = fmax(max_err_asin, err_asin);
+		  max_err_acos = fmax(max_err_acos, err_acos);
+	  }
+	  // The tails are the most sensitive part, test them densely.
+	  for (x = fix32_one - 100000; x <= fix32_one; x++)
+	  {
+		  double dx = fix32_to_dbl(x);
+		  max_err_asin = fmax(max_err_asin, fabs(fix32_to_dbl(fix32_asin(-x)) - asin(-dx)));
+		  max_err_acos = fmax(max_err_acos, fabs(fix32_to_dbl(fix32_acos(x)) - acos(dx)));
+	  }
+	  printf("[asin]: max error: %.3f LSB\n", max_err_asin * 4294967296.0);
+	  printf("[acos]: max error: %.3f LSB\n", max_err_acos * 4294967296.0);
+	  TEST(max_err_asin < 2.5 / 4294967296.0);
+	  TEST(max_err_acos < 2.5 / 4294967296.0);
+	  TEST(fix32_asin(0) == 0);
+	  TEST(fix32_asin(fix32_one) == fix32_pi_over_2);
+	  TEST(fix32_acos(fix32_one) == 0);
+	  TEST(delta(fix32_acos(-fix32_one), fix32_pi) <= 1);
+  }
+
+  {
+	  COMMENT("Testing tangent accuracy");
+	  // Below |tan| = 1 the error is measured in LSB, above it relative to
+	  // the result, as the slope grows without bound towards the poles.
+	  double max_err_lsb = 0, max_err_rel = 0;
+	  fix32_t x;
+	  for (x = -fix32_from_int(7); x <= fix32_from_int(7); x += 69809)
+	  {
+		  long double dResult = tanl((long double)x / 4294967296.0L);
+		  long double err = fabsl((long double)fix32_tan(x) / 4294967296.0L - dResult);
+		  if (fabsl(dResult) >= 2147483648.0L)
+			  continue;
+		  if (fabsl(dResult) <= 1)
+			  max_err_lsb = fmax(max_err_lsb, err * 4294967296.0);
+		  else
+			  max_err_rel = fmax(max_err_rel, err / fabsl(dResult));
+	  }
+	  printf("[tan]: max error: %.3f LSB, %.3g relative\n", max_err_lsb, max_err_rel);
+	  TEST(max_err_lsb < 1.0);
+	  TEST(max_err_rel < 1e-9);
+	  TEST(fix32_tan(0) == 0);
+	  TEST(fix32_tan(fix32_pi >> 2) == fix32_one);
+	  TEST(fix32_tan(-(fix32_pi >> 2)) == -fix32_one);
+	  // Saturates on both sides of the pole.
+	  TEST(fix32_tan(fix32_pi_over_2) == fix32_maximum);
+	  TEST(fix32_tan(fix32_pi_over_2 + 1) == fix32_minimum);
+	  TEST(fix32_tan(-fix32_pi_over_2) == fix32_minimum);
+  }
+
+  {
+	  COMMENT("Testing arctangent accuracy tiers");
+	  fix32_t (*const tiers[])(fix32_t, fix32_t) = { fix32_atan2_fast, fix32_atan2_mid, fix32_atan2 };
+	  const char *names[] = { "atan2_fast", "atan2_mid", "atan2" };
+	  const double bounds[] = { 1.0 / 65536, 1.0 / 16777216, 2.0 / 4294967296.0 };
+	  for (int t = 0; t < 3; ++t)
+	  {
+		  double max_err = 0;
+		  double max_err_angle = 0;
+		  for (int i = 0; i < 100000; ++i)
+		  {
+			  double angle = 2 * M_PI * ((double)i / 100000 - 0.5);
+			  double radius = (i % 7 == 0) ? 1e-6 : 1 + (i % 3000) * 1000.0;
+			  fix32_t x = fix32_from_dbl(cos(angle) * radius);
+			  fix32_t y = fix32_from_dbl(sin(angle) * radius);
+			  double dResult = atan2(fix32_to_dbl(y), fix32_to_dbl(x));
+			  double err = fabs(fix32_to_dbl(tiers[t](y, x)) - dResult);
+			  if (err > max_err)
+			  {
+				  max_err = err;
+				  max_err_angle = angle;
+			  }
+		  }
+		  printf("[%s]: max error: %.12f, when angle = %.10f\n", names[t], max_err, max_err_angle);
+		  TEST(max_err < bounds[t]);
+	  }
+
+	  TEST(fix32_atan2(0, 0) == 0);
+	  TEST(delta(fix32_atan2(0, -fix32_one), fix32_pi) <= 1);
+	  TEST(fix32_atan2(fix32_one, 0) == fix32_pi_over_2);
+	  TEST(fix32_atan2(-fix32_one, 0) == -fix32_pi_over_2);
+	  TEST(delta(fix32_atan(fix32_one), fix32_pi >> 2) <= 1);
+	  TEST(delta(fix32_atan(fix32_from_int(-1000)), fix32_from_dbl(atan(-1000))) <= 1);
+  }
+
+  {
+	  COMMENT("Testing sine, cosine and square root precision tiers");
+	  fix32_t (*const tiers[])(fix32_t) = { fix32_sin_fast, fix32_sin_mid, fix32_cos_fast, fix32_cos_mid,
+	                                        fix32_sqrt_fast, fix32_sqrt_mid };
+	  const char *names[] = { "sin_fast", "sin_mid", "cos_fast", "cos_mid", "sqrt_fast", "sqrt_mid" };
+	  for (int t = 0; t < 6; ++t)
+	  {
+		  double max_err = 0;
+		  fix32_t max_err_x = 0;
+		  uint64_t seed = 12345;
+		  for (int i = 0; i < 200000; ++i)
+		  {
+			  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			  fix32_t x = (fix32_t)seed >> (seed & 31);
+			  long double real = (long double)x / 4294967296.0L;
+			  long double dResult = (t < 2) ? sinl(real) : (t < 4) ? cosl(real)
+			                      : (x < 0 ? -sqrtl(-real) : sqrtl(real));
+			  double err = fabsl((long double)tiers[t](x) / 4294967296.0L - dResult);
+			  // Relative above 1, for the square roots.
+			  if (fabsl(dResult) > 1)
+				  err /= fabsl(dResult);
+			  if (err > max_err)
+			  {
+				  max_err = err;
+				  max_err_x = x;
+			  }
+		  }
+		  printf("[%s]: max error: %.3g, when x = %.10f\n", names[t], max_err, fix32_to_dbl(max_err_x));
+		  TEST(max_err < ((t & 1) ? 1.0 / 16777216 : 1.0 / 65536));
+	  }
+
+	  TEST(fix32_sin_fast(0) == 0);
+	  TEST(fix32_sqrt_fast(0) == 0);
+	  TEST(fix32_sqrt_mid(fix32_from_int(-4)) == -fix32_sqrt_mid(fix32_from_int(4)));
+	  TEST(delta(fix32_sqrt_mid(fix32_from_int(4)), fix32_from_int(2)) <= 256);
+  }
+
+  {
+	  COMMENT("Testing binary angle trigonometric functions");
+	  const int TRIG_TEST_SAMPLES = 100000;
+	  double max_err = 0;
+	  uint32_t max_err_turns = 0;
+	  for (int i = 0; i < TRIG_TEST_SAMPLES; ++i)
+	  {
+		  uint32_t turns = (uint32_t)i * 2654435761u;
+		  double angle = 2 * M_PI * turns / 4294967296.0;
+		  fix32_t fSin, fCos;
+		  fix32_sincos_turns(turns, &fSin, &fCos);
+		  double err = fmax(fabs(fix32_to_dbl(fSin) - sin(angle)), fabs(fix32_to_dbl(fCos) - cos(angle)));
+		  if (fSin != fix32_sin_turns(turns) || fCos != fix32_cos_turns(turns))
+			  err = 1;
+		  if (err > max_err)
+		  {
+			  max_err = err;
+			  max_err_turns = turns;
+		  }
+	  }
+	  printf("[sincos_turns]: max error: %.12f, when turns = %08x\n", max_err, max_err_turns);
+	  TEST(max_err < 2.0 / 4294967296.0);
+
+	  max_err = 0;
+	  for (int i = 0; i < TRIG_TEST_SAMPLES; ++i)
+	  {
+		  double angle = 2 * M_PI * ((double)i / TRIG_TEST_SAMPLES - 0.5);
+		  fix32_t x = fix32_from_dbl(cos(angle) * (1 + i % 1000));
+		  fix32_t y = fix32_from_dbl(sin(angle) * (1 + i % 1000));
+		  double dResult = atan2(fix32_to_dbl(y), fix32_to_dbl(x)) / (2 * M_PI) * 4294967296.0;
+		  double err = fabs(remainder(fix32_atan2_turns(y, x) - dResult, 4294967296.0));
+		  if (err > max_err)
+			  max_err = err;
+	  }
+	  printf("[atan2_turns]: max error: %.6f turns LSB\n", max_err);
+	  TEST(max_err <= 1.0);
+
+	  TEST(fix32_rad_to_turns(fix32_pi) == 0x80000000);
+	  TEST(fix32_rad_to_turns(-fix32_pi_over_2) == 0xC0000000);
+	  TEST(fix32_deg_to_turns(fix32_from_int(90)) == 0x40000000);
+	  TEST(fix32_turns_to_deg(0xC0000000) == fix32_from_int(-90));
+	  TEST(fix32_turns_to_deg(0x80000000) == fix32_from_int(-180));
+	  TEST(delta(fix32_turns_to_rad(0x40000000), fix32_pi_over_2) <= 1);
+	  TEST(fix32_sin_turns(0) == 0);
+	  TEST(fix32_sin_turns(0x40000000) == fix32_one);
+	  TEST(fix32_cos_turns(0x80000000) == -fix32_one);
+	  TEST(fix32_atan2_turns(0, 0) == 0);
+	  TEST(fix32_atan2_turns(fix32_one, 0) == 0x40000000);
+	  TEST(fix32_atan2_turns(0, -fix32_one) == 0x80000000);
+	  TEST(fix32_atan2_turns(-fix32_one, -fix32_one) == 0xA0000000);
+  }
   
 #ifndef FIXMATH_NO_ROUNDING
   {
@@ -441,12 +802,16 @@ int main()
   
 #ifndef FIXMATH_NO_ROUNDING
   {
-  	// TODO: FIX TESTS!
     COMMENT("Testing square root rounding corner cases");
-    //TEST(fix32_sqrt(214748302) == 3751499);
-    //TEST(fix32_sqrt(214748303) == 3751499);
-    //TEST(fix32_sqrt(214748359) == 3751499);
-    //TEST(fix32_sqrt(214748360) == 3751500);
+    // The exact roots are 2e-6 above and 3e-5 below a half, and
+    // (2^32 - 1) * 2^32 = r^2 + r is just below (r + 1/2)^2.
+    TEST(fix32_sqrt(777896675611076LL) == 1827851411198LL);
+    TEST(fix32_sqrt(359380601939964LL) == 1242387995816LL);
+    TEST(fix32_sqrt(4294967295LL) == 4294967295LL);
+    TEST(fix32_sqrt(fix32_maximum) == 199032864766430LL);
+    // Above 2^62 the former digit by digit version was sometimes 1 LSB low.
+    TEST(fix32_sqrt(6916980472166024763LL) == 172360682625197LL);
+    TEST(fix32_sqrt(fix32_minimum) == -199032864766430LL);
   }
 #endif
   
@@ -476,6 +841,162 @@ int main()
     
     TEST(failures == 0);
   }
+
+  {
+    COMMENT("Testing inverse square root and normalization");
+    double max_err = 0;
+    uint64_t seed = 7;
+    int i;
+    for (i = 0; i < 100000; i++)
+    {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      fix32_t x = (fix32_t)(seed >> 1) >> (seed & 63);
+      if (x <= 0) continue;
+      long double resultf = 4294967296.0L / sqrtl((long double)x / 4294967296.0L);
+      double err = fabsl(fix32_rsqrt(x) - resultf);
+      if (err > max_err) max_err = err;
+    }
+    printf("[rsqrt]: max error: %.3f LSB\n", max_err);
+    TEST(max_err <= 1);
+    TEST(fix32_rsqrt(fix32_from_int(4)) == fix32_one / 2);
+    TEST(fix32_rsqrt(0) == fix32_overflow);
+
+    max_err = 0;
+    for (i = 0; i < 100000; i++)
+    {
+      fix32_t v[3], w[3];
+      long double sum = 0;
+      int j, n = 2 + (i & 1);
+      for (j = 0; j < n; j++)
+      {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        v[j] = w[j] = (fix32_t)seed >> ((seed >> 32) & 63);
+        sum += (long double)v[j] * v[j];
+      }
+      if (n == 2)
+        fix32_normalize2(&w[0], &w[1]);
+      else
+        fix32_normalize3(&w[0], &w[1], &w[2]);
+      for (j = 0; j < n; j++)
+      {
+        double err = fabsl(w[j] - v[j] / sqrtl(sum) * 4294967296.0L);
+        if (err > max_err) max_err = err;
+      }
+    }
+    printf("[normalize2, normalize3]: max error: %.3f LSB\n", max_err);
+    TEST(max_err <= 1);
+
+    fix32_t x = fix32_from_int(3), y = fix32_from_int(-4), z = 0;
+    fix32_normalize2(&x, &y);
+    TEST(delta(x, fix32_from_dbl(0.6)) <= 1 && delta(y, fix32_from_dbl(-0.8)) <= 1);
+    x = fix32_maximum; y = fix32_maximum; z = 0;
+    fix32_normalize3(&x, &y, &z);
+    TEST(x == y && delta(x, fix32_from_dbl(M_SQRT1_2)) <= 1 && z == 0);
+    x = 0; y = 0;
+    fix32_normalize2(&x, &y);
+    TEST(x == 0 && y == 0);
+  }
+
+  {
+    COMMENT("Testing hypot");
+    double max_err = 0;
+    uint64_t seed = 11;
+    int i;
+    for (i = 0; i < 100000; i++)
+    {
+      fix32_t v[3];
+      long double sum = 0;
+      int j, n = 2 + (i & 1);
+      for (j = 0; j < n; j++)
+      {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        v[j] = (fix32_t)seed >> ((seed >> 32) % 40 + 8);
+        sum += (long double)v[j] * v[j];
+      }
+      fix32_t result = (n == 2) ? fix32_hypot(v[0], v[1]) : fix32_hypot3(v[0], v[1], v[2]);
+      double err = fabsl(result - sqrtl(sum));
+      if (err > max_err) max_err = err;
+    }
+    printf("[hypot, hypot3]: max error: %.3f LSB\n", max_err);
+    TEST(max_err <= 1);
+
+    // Far beyond where the sum of squares overflows Q31.32.
+    TEST(fix32_hypot(fix32_from_int(300000), fix32_from_int(-400000)) == fix32_from_int(500000));
+    TEST(fix32_hypot3(fix32_from_int(-2000000), fix32_from_int(3000000), fix32_from_int(6000000)) == fix32_from_int(7000000));
+    TEST(fix32_hypot(fix32_maximum, fix32_maximum) == fix32_maximum);
+    TEST(fix32_hypot(fix32_minimum, 0) == fix32_maximum);
+    TEST(fix32_hypot(0, 0) == 0);
+
+    fix32_t pairs[6] = { fix32_from_int(3), fix32_from_int(4), 0, -fix32_one, fix32_from_int(-5), fix32_from_int(12) };
+    fix32_t out[3];
+    fix32_hypot_array(pairs, out, 3);
+    TEST(out[0] == fix32_from_int(5) && out[1] == fix32_one && out[2] == fix32_from_int(13));
+  }
+
+  {
+    COMMENT("Testing sqrt, rsqrt and magnitude arrays");
+    // Odd length for the tail of the vector kernels, magnitudes on both
+    // sides of 2^18 where the vector kernels hand lanes to fix32_hypot.
+    enum { ARRAY_LEN = 1001 };
+    fix32_t re[ARRAY_LEN], im[ARRAY_LEN], out[ARRAY_LEN];
+    uint64_t seed = 17;
+    int i, sqrt_diff = 0, mag_diff = 0;
+    double rsqrt_err = 0;
+    for (i = 0; i < ARRAY_LEN; i++)
+    {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      re[i] = (fix32_t)seed >> ((seed >> 32) % 52 + 8);
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      im[i] = (fix32_t)seed >> ((seed >> 32) % 52 + 8);
+    }
+    re[0] = 0; im[0] = 0;
+    re[1] = fix32_minimum; im[1] = fix32_maximum;
+
+    fix32_sqrt_array(re, out, ARRAY_LEN);
+    for (i = 0; i < ARRAY_LEN; i++)
+      sqrt_diff += (out[i] != fix32_sqrt(re[i]));
+    fix32_rsqrt_array(re, out, ARRAY_LEN);
+    for (i = 0; i < ARRAY_LEN; i++)
+    {
+      double err = (re[i] <= 0) ? (out[i] != fix32_overflow)
+        : fabsl(out[i] - 281474976710656.0L / sqrtl((long double)re[i]));
+      if (err > rsqrt_err) rsqrt_err = err;
+    }
+    fix32_magnitude_array(re, im, out, ARRAY_LEN);
+    for (i = 0; i < ARRAY_LEN; i++)
+      mag_diff += (out[i] != fix32_hypot(re[i], im[i]));
+    printf("[sqrt_array, magnitude_array]: %d and %d differences, [rsqrt_array]: max error: %.3f LSB\n",
+      sqrt_diff, mag_diff, rsqrt_err);
+    TEST(sqrt_diff == 0 && mag_diff == 0 && rsqrt_err <= 1);
+
+    // In place, and the length is respected.
+    fix32_t next = re[3];
+    fix32_magnitude_array(re, im, re, 3);
+    TEST(re[0] == 0 && re[1] == fix32_maximum && re[2] == out[2] && re[3] == next);
+  }
+
+  {
+    COMMENT("Testing cube root");
+    double max_err = 0;
+    uint64_t seed = 13;
+    int i;
+    for (i = 0; i < 100000; i++)
+    {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      fix32_t x = (fix32_t)seed >> ((seed >> 32) & 63);
+      long double resultf = cbrtl((long double)x / 4294967296.0L) * 4294967296.0L;
+      double err = fabsl(fix32_cbrt(x) - resultf);
+      if (err > max_err) max_err = err;
+    }
+    printf("[cbrt]: max error: %.3f LSB\n", max_err);
+    TEST(max_err <= 1);
+
+    TEST(fix32_cbrt(fix32_from_int(27)) == fix32_from_int(3));
+    TEST(fix32_cbrt(fix32_from_int(-1000000)) == fix32_from_int(-100));
+    TEST(fix32_cbrt(fix32_one >> 3) == fix32_one >> 1);
+    TEST(delta(fix32_cbrt(fix32_minimum), -fix32_from_int(1290) - 683565917) <= 1);
+    TEST(fix32_cbrt(0) == 0);
+  }
   
   if (status != 0)
     fprintf(stdout, "\n\nSome tests FAILED!\n");